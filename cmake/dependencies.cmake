@@ -3,7 +3,7 @@ set(LIBS_DIRS "")
 list(APPEND CMAKE_MODULE_PATH "${CMAKE_SOURCE_DIR}/cmake/modules")
 
 # Find Boost
-FIND_PACKAGE(Boost REQUIRED filesystem system)
+FIND_PACKAGE(Boost REQUIRED filesystem system iostreams)
 
 set(Boost_USE_STATIC_LIBS        ON)
 set(Boost_USE_MULTITHREADED      ON)
@@ -11,7 +11,11 @@ set(Boost_USE_STATIC_RUNTIME     OFF)
 set(BOOST_ALL_DYN_LINK           OFF)
 
 include_directories(SYSTEM ${Boost_INCLUDE_DIRS})
-list(APPEND LIBS ${Boost_FILESYSTEM_LIBRARY} ${Boost_SYSTEM_LIBRARY})
+list(APPEND LIBS ${Boost_FILESYSTEM_LIBRARY} ${Boost_SYSTEM_LIBRARY} ${Boost_IOSTREAMS_LIBRARY})
+
+# Find Threads
+find_package(Threads REQUIRED)
+list(APPEND LIBS ${CMAKE_THREAD_LIBS_INIT})
 
 # Find CGAL
 FIND_PACKAGE(CGAL REQUIRED)
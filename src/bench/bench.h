@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+namespace city
+{
+    /** @defgroup bench Benchmarks
+    *  Small timing helpers shared by the benchmark executables
+    *  @{
+    */
+    namespace bench
+    {
+        /**
+        * Times a function.
+        * @tparam Function callable without arguments
+        * @param function the function to time
+        * @param repetitions number of consecutive calls
+        * @return mean duration of a call in milliseconds
+        */
+        template<typename Function>
+        double time(Function function, std::size_t const repetitions = 1)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for(std::size_t repetition(0); repetition != repetitions; ++repetition)
+                function();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            return elapsed.count() / static_cast<double>(repetitions);
+        }
+
+        /**
+        * Prints a timing line.
+        * @param name benchmark name
+        * @param milliseconds measured duration
+        */
+        inline void report(std::string const& name, double const milliseconds)
+        {
+            std::ios::fmtflags flag_buffer = std::cout.flags();
+            std::cout << std::left << std::setw(48) << name << std::right << std::setw(14) << std::fixed << std::setprecision(3) << milliseconds << " ms" << std::endl;
+            std::cout.flags(flag_buffer);
+        }
+    }
+    /** @} */ // end of bench
+}
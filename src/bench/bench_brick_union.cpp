@@ -0,0 +1,107 @@
+#include "bench.h"
+
+#include <io/io_off.h>
+#include <io/io_3ds.h>
+
+#include <scene/unode.h>
+#include <projection/scene_projection.h>
+#include <projection/utilities.h>
+#include <algorithms/util_algorithms.h>
+
+#include <CGAL/Boolean_set_operations_2.h>
+
+#include <boost/filesystem.hpp>
+
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+
+void bench_footprint(std::string const& name, city::scene::UNode const& unode)
+{
+    city::projection::FootPrint footprint;
+    city::bench::report(
+        name + ": footprint",
+        city::bench::time(
+            [&footprint, &unode]()
+            {
+                footprint = city::projection::FootPrint(unode);
+            }
+        )
+    );
+
+    /* Occlusion queries of each insertion read the union, joined with every added facet once built */
+    std::vector<city::projection::FacePrint> prints = city::projection::orthoprint(unode);
+    city::bench::report(
+        name + ": BrickPrint::operator+= sequence",
+        city::bench::time(
+            [&prints]()
+            {
+                city::projection::BrickPrint brick;
+                for(auto const& facet : prints)
+                    brick += facet;
+            }
+        )
+    );
+
+    city::bench::report(
+        name + ": edge lengths, union rebuilt",
+        city::bench::time(
+            [&footprint]()
+            {
+                city::Polygon_set ps;
+                for(auto const& facet : footprint)
+                    ps.join(facet.get_polygon());
+                std::vector<city::Polygon_with_holes> polygons;
+                ps.polygons_with_holes(std::back_inserter(polygons));
+
+                std::vector<double> lengths;
+                for(auto const& polygon : polygons)
+                {
+                    auto buffer = city::edge_lengths(polygon.outer_boundary());
+                    lengths.insert(std::end(lengths), std::begin(buffer), std::end(buffer));
+                }
+            },
+            10
+        )
+    );
+
+    /* Repeated calls: after the first one, these only read the cached union */
+    city::bench::report(
+        name + ": edge lengths, repeated calls",
+        city::bench::time(
+            [&footprint]()
+            {
+                footprint.edge_lengths();
+            },
+            10
+        )
+    );
+}
+
+int main(int, const char**)
+{
+    try
+    {
+        city::scene::UNode hammerhead(
+            city::io::OFFHandler(
+                boost::filesystem::path("../../ressources/3dModels/OFF/hammerhead.off"),
+                std::map<std::string, bool>{{"read", true}}
+            ).read()
+        );
+        bench_footprint("hammerhead", hammerhead);
+
+        city::scene::UNode santa(
+            city::io::T3DSHandler(
+                boost::filesystem::path("../../ressources/3dModels/3DS/Toy/Toy Santa Claus N180816.3DS"),
+                std::map<std::string, bool>{{"read", true}}
+            ).mesh("Staff", std::set<char>{'S'})
+        );
+        bench_footprint("santa staff", santa);
+    }
+    catch(std::exception const& except)
+    {
+        std::cerr << except.what() << std::flush << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
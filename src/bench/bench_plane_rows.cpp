@@ -0,0 +1,89 @@
+#include "bench.h"
+
+#include <algorithms/raster_algorithms.h>
+#include <algorithms/test_utils.h>
+
+#include <projection/face_projection.h>
+
+#include <vector>
+
+int main(int, const char**)
+{
+    city::InexactToExact to_exact;
+    city::Point_3 A(to_exact(city::InexactKernel::Point_3(0., 0., 12.))),
+                  B(to_exact(city::InexactKernel::Point_3(100., 0., 14.5))),
+                  C(to_exact(city::InexactKernel::Point_3(0., 100., 9.75)));
+    auto facet = test_facet_projection(0, A, B, C);
+
+    std::size_t const width(2048), height(2048);
+    double const pixel_size(100. / static_cast<double>(width));
+    std::vector<double> image(width * height, 0.);
+    std::vector<short> hits(width * height, 0);
+
+    std::cout << "AVX2 kernel: " << std::boolalpha << city::vectorized_plane_rows() << std::endl;
+
+    city::bench::report(
+        "per pixel get_plane_height",
+        city::bench::time(
+            [&facet, &image, &hits, width, height, pixel_size]()
+            {
+                for(std::size_t row(0); row != height; ++row)
+                    for(std::size_t column(0); column != width; ++column)
+                    {
+                        std::size_t index = row * width + column;
+                        double z = facet.get_plane_height(
+                            city::InexactPoint_2(
+                                (static_cast<double>(column) + .5) * pixel_size,
+                                100. - (static_cast<double>(row) + .5) * pixel_size
+                            )
+                        );
+                        image[index] = (image[index] * static_cast<double>(hits[index]) + z) / static_cast<double>(++hits[index]);
+                    }
+            }
+        )
+    );
+
+    city::ExactToInexact to_inexact;
+    city::Plane_3 const& plane = facet.get_plane();
+    double c = to_inexact(plane.c()),
+           alpha = - to_inexact(plane.d()) / c,
+           beta = - to_inexact(plane.a()) / c,
+           gamma = - to_inexact(plane.b()) / c;
+
+    city::bench::report(
+        "scalar plane rows",
+        city::bench::time(
+            [&image, &hits, width, height, pixel_size, alpha, beta, gamma]()
+            {
+                for(std::size_t row(0); row != height; ++row)
+                    city::accumulate_plane_row_scalar(
+                        image.data() + row * width,
+                        hits.data() + row * width,
+                        width,
+                        alpha + beta * .5 * pixel_size + gamma * (100. - (static_cast<double>(row) + .5) * pixel_size),
+                        beta * pixel_size
+                    );
+            },
+            10
+        )
+    );
+    city::bench::report(
+        "dispatched plane rows",
+        city::bench::time(
+            [&image, &hits, width, height, pixel_size, alpha, beta, gamma]()
+            {
+                for(std::size_t row(0); row != height; ++row)
+                    city::accumulate_plane_row(
+                        image.data() + row * width,
+                        hits.data() + row * width,
+                        width,
+                        alpha + beta * .5 * pixel_size + gamma * (100. - (static_cast<double>(row) + .5) * pixel_size),
+                        beta * pixel_size
+                    );
+            },
+            10
+        )
+    );
+
+    return EXIT_SUCCESS;
+}
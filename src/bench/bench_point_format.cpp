@@ -0,0 +1,72 @@
+#include "bench.h"
+
+#include <shadow/point.h>
+
+#include <io/Point_format/point_format.h>
+
+#include <vector>
+#include <sstream>
+#include <random>
+
+int main(int, const char**)
+{
+    /* Lambert 93 like coordinates, as read from georeferenced scenes */
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> easting(640000., 660000.),
+                                           northing(6850000., 6870000.),
+                                           height(20., 120.);
+    std::vector<city::shadow::Point> points(1000000);
+    for(auto & point : points)
+        point = city::shadow::Point(easting(generator), northing(generator), height(generator));
+
+    std::size_t written(0);
+
+    city::bench::report(
+        "ostream operator<<",
+        city::bench::time(
+            [&points, &written]()
+            {
+                std::ostringstream output;
+                for(auto const& point : points)
+                    output << point << '\n';
+                written += output.str().size();
+            }
+        )
+    );
+    city::bench::report(
+        "ostream operator<<, 17 digits",
+        city::bench::time(
+            [&points, &written]()
+            {
+                std::ostringstream output;
+                output.precision(17);
+                for(auto const& point : points)
+                    output << point << '\n';
+                written += output.str().size();
+            }
+        )
+    );
+
+    std::vector<int> const precisions{city::io::Point_format::round_trip, 3, 2};
+    for(auto const decimals : precisions)
+        city::bench::report(
+            decimals == city::io::Point_format::round_trip ? "Point_format, round trip" : "Point_format, " + std::to_string(decimals) + " decimals",
+            city::bench::time(
+                [&points, &written, decimals]()
+                {
+                    std::ostringstream output;
+                    {
+                        city::io::Buffered_stream out(output);
+                        city::io::Point_format format(decimals);
+                        for(auto const& point : points)
+                            format.write(out, point) << '\n';
+                    }
+                    written += output.str().size();
+                }
+            )
+        );
+
+    std::cout << written << " characters written" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,164 @@
+#include "bench.h"
+
+#include <shadow/mesh.h>
+
+#include <io/Off_stream/off_stream.h>
+#include <io/Point_format/point_format.h>
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <random>
+#include <numeric>
+#include <iterator>
+
+int main(int, const char**)
+{
+    /* A regular grid of 1000 x 1000 points and two triangles per cell */
+    std::size_t const side(1000);
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> height(20., 120.);
+
+    std::vector<city::shadow::Point> points;
+    points.reserve(side * side);
+    for(std::size_t row(0); row != side; ++row)
+        for(std::size_t column(0); column != side; ++column)
+            points.push_back(city::shadow::Point(650000. + static_cast<double>(column), 6860000. + static_cast<double>(row), height(generator)));
+
+    std::vector<city::shadow::Face> faces;
+    faces.reserve(2 * (side - 1) * (side - 1));
+    for(std::size_t row(0); row != side - 1; ++row)
+        for(std::size_t column(0); column != side - 1; ++column)
+        {
+            std::size_t corner = row * side + column;
+            faces.push_back(city::shadow::Face{corner, corner + 1, corner + side + 1});
+            faces.push_back(city::shadow::Face{corner, corner + side + 1, corner + side});
+        }
+
+    city::shadow::Mesh mesh("grid", points, faces);
+    std::size_t checksum(0);
+
+    city::bench::report(
+        "copy the point vector",
+        city::bench::time(
+            [&points, &checksum]()
+            {
+                std::vector<city::shadow::Point> copy(points);
+                checksum += copy.size();
+            },
+            10
+        )
+    );
+    city::bench::report(
+        "copy the mesh",
+        city::bench::time(
+            [&mesh, &checksum]()
+            {
+                city::shadow::Mesh copy(mesh);
+                checksum += copy.points_size();
+            },
+            10
+        )
+    );
+    city::bench::report(
+        "Mesh::operator+=",
+        city::bench::time(
+            [&mesh, &checksum]()
+            {
+                city::shadow::Mesh sum(mesh);
+                sum += mesh;
+                checksum += sum.points_size();
+            },
+            10
+        )
+    );
+
+    /* Terrain assembly: many small chunks of 20 x 20 points */
+    std::vector<city::shadow::Mesh> chunks;
+    chunks.reserve(200);
+    for(std::size_t chunk(0); chunk != 200; ++chunk)
+    {
+        std::vector<city::shadow::Point> chunk_points;
+        std::vector<city::shadow::Face> chunk_faces;
+        for(std::size_t row(0); row != 20; ++row)
+            for(std::size_t column(0); column != 20; ++column)
+            {
+                chunk_points.push_back(points[(chunk % 40 * 19 + row) * side + chunk / 40 * 19 + column]);
+                if(row != 19 && column != 19)
+                    chunk_faces.push_back(city::shadow::Face{row * 20 + column, row * 20 + column + 1, row * 20 + column + 21});
+            }
+        chunks.push_back(city::shadow::Mesh("chunk", chunk_points, chunk_faces));
+    }
+
+    city::bench::report(
+        "sum of 200 chunks with std::accumulate",
+        city::bench::time(
+            [&chunks, &checksum]()
+            {
+                checksum += std::accumulate(std::begin(chunks), std::end(chunks), city::shadow::Mesh()).points_size();
+            },
+            1
+        )
+    );
+    city::bench::report(
+        "Mesh::concatenate of 200 chunks",
+        city::bench::time(
+            [&chunks, &checksum]()
+            {
+                checksum += city::shadow::Mesh::concatenate(std::begin(chunks), std::end(chunks)).points_size();
+            },
+            10
+        )
+    );
+
+    /* Triangle soup of the first 500 x 500 grid points, every triangle having its own points */
+    std::size_t const soup_side(500);
+    std::vector<city::shadow::Point> soup_points;
+    std::vector<city::shadow::Face> soup_faces;
+    soup_points.reserve(6 * (soup_side - 1) * (soup_side - 1));
+    soup_faces.reserve(2 * (soup_side - 1) * (soup_side - 1));
+    for(std::size_t row(0); row != soup_side - 1; ++row)
+        for(std::size_t column(0); column != soup_side - 1; ++column)
+        {
+            std::size_t corner = row * side + column;
+            for(auto const& triangle : {std::vector<std::size_t>{corner, corner + 1, corner + side + 1}, std::vector<std::size_t>{corner, corner + side + 1, corner + side}})
+            {
+                std::size_t first = soup_points.size();
+                for(auto const index : triangle)
+                    soup_points.push_back(points[index]);
+                soup_faces.push_back(city::shadow::Face{first, first + 1, first + 2});
+            }
+        }
+    city::shadow::Mesh soup("soup", soup_points, soup_faces);
+    std::string const weld_name("Mesh::weld of a " + std::to_string(soup.points_size()) + " points soup");
+
+    city::bench::report(
+        weld_name,
+        city::bench::time(
+            [&soup, &checksum]()
+            {
+                checksum += soup.weld(1e-3).points_size();
+            }
+        )
+    );
+    std::cout << "  welded to " << soup.points_size() << " points" << std::endl;
+
+    std::stringstream off_text;
+    city::io::Off_stream(off_text, 3) << mesh;
+    std::string const buffer(off_text.str());
+
+    city::bench::report(
+        "OFF parsing",
+        city::bench::time(
+            [&buffer, &checksum]()
+            {
+                checksum += city::io::Off_stream::parse(buffer.data(), buffer.data() + buffer.size()).points_size();
+            },
+            10
+        )
+    );
+
+    std::cout << checksum << " points handled" << std::endl;
+
+    return EXIT_SUCCESS;
+}
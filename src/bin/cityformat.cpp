@@ -6,11 +6,13 @@
 
 #include <boost/filesystem.hpp>
 
+#include <map>
+
 static const char USAGE[]=
 R"(cityformat.
 
     Usage:
-      cityformat <scene> --input-format=<input_frmt> [--prune --graphs --terrain] [output <path> --output-format=<output_format>]
+      cityformat <scene> --input-format=<input_frmt> [--prune --graphs --graph-format=<graph_format> --terrain --weld=<tolerance>] [output <path> --output-format=<output_format>]
       cityformat --formats
       cityformat (-h | --help)
       cityformat --version
@@ -20,7 +22,9 @@ R"(cityformat.
       --prune                               Prune building faces.
       --input-format=<input_frmt>           Specify input format.
       --graphs                              Save the building facets dual graph.
+      --graph-format=<graph_format>         Dual graph format: sparse, dense or binary [default: sparse].
       --terrain                             Taking care of terrain.
+      --weld=<tolerance>                    Weld mesh points closer than the tolerance on load.
       --output-format=<output_frmt>         Specify output format.
       --formats                             Give all possible formats.
 )";
@@ -33,7 +37,9 @@ struct Arguments
         std::string input_format;
         bool prune = false;
         bool graphs = false;
+        city::io::AdjacencyFormat graph_format = city::io::AdjacencyFormat::sparse;
         bool terrain = false;
+        double weld_tolerance = city::scene::Scene::no_welding;
     };
     struct SaveArguments
     {
@@ -52,7 +58,18 @@ struct Arguments
             scene_args.input_format = docopt_args.at("--input-format").asString();
             scene_args.prune = docopt_args.at("--prune").asBool();
             scene_args.graphs = docopt_args.at("--graphs").asBool();
+            std::map<std::string, city::io::AdjacencyFormat> const graph_formats{{
+                {"sparse", city::io::AdjacencyFormat::sparse},
+                {"dense", city::io::AdjacencyFormat::dense},
+                {"binary", city::io::AdjacencyFormat::binary}
+            }};
+            auto graph_format = graph_formats.find(docopt_args.at("--graph-format").asString());
+            if(graph_format == std::end(graph_formats))
+                throw std::runtime_error("Unknown dual graph format: " + docopt_args.at("--graph-format").asString());
+            scene_args.graph_format = graph_format->second;
             scene_args.terrain = docopt_args.at("--terrain").asBool();
+            if(docopt_args.at("--weld"))
+                scene_args.weld_tolerance = std::stod(docopt_args.at("--weld").asString());
             
             save_args.output_path = docopt_args.at("<path>").asString();
             save_args.output_format = docopt_args.at("--output-format").asString();
@@ -79,7 +96,9 @@ inline std::ostream & operator <<(std::ostream & os, Arguments & arguments)
            << "  Input format: " << arguments.scene_args.input_format << std::endl
            << "  Pruning faces: " << arguments.scene_args.prune << std::endl
            << "  Taking care of terrain: " << arguments.scene_args.terrain << std::endl
+           << "  Welding tolerance: " << arguments.scene_args.weld_tolerance << std::endl
            << "  Saving dual graphs: " << arguments.scene_args.graphs << std::endl
+           << "  Dual graph format: " << (arguments.scene_args.graph_format == city::io::AdjacencyFormat::dense ? "dense" : arguments.scene_args.graph_format == city::io::AdjacencyFormat::binary ? "binary" : "sparse") << std::endl
            << "  Output path: " << arguments.save_args.output_path << std::endl
            << "  Output format: " << arguments.save_args.output_format << std::endl;
 
@@ -115,7 +134,9 @@ int main(int argc, const char** argv)
             auto scene = city::io::SceneHandler(
                 arguments.scene_args.input_path,
                 std::map<std::string, bool>{{"read", true}},
-                arguments.scene_args.input_format
+                arguments.scene_args.input_format,
+                1,
+                arguments.scene_args.weld_tolerance
             ).read();
 
             if(arguments.scene_args.prune)
@@ -124,7 +145,8 @@ int main(int argc, const char** argv)
             if(arguments.scene_args.graphs)
                 city::save_building_duals(
                     arguments.scene_args.input_path.parent_path(),
-                    scene
+                    scene,
+                    arguments.scene_args.graph_format
                 );
 
             city::io::SceneHandler scene_writer(
@@ -10,25 +10,34 @@
 
 #include <ostream>
 #include <string>
+#include <map>
+#include <utility>
 
 static const char USAGE[]=
 R"(orthoproject.
 
     Usage:
-      orthoproject <scene> --input-format=<input_frmt> [--prune --graphs --terrain] [save --scene --labels] [rasterize --pixel-size=<size>]
+      orthoproject <scene> --input-format=<input_frmt> [--prune --cache --graphs --graph-format=<graph_format> --terrain --threads=<threads> --weld=<tolerance>] [save --scene --labels] [rasterize --pixel-size=<size> --exact-raster --sample-type=<type> --height-scale=<scale> --height-offset=<offset>]
       orthoproject (-h | --help)
       orthoproject --version
     Options:
       -h --help                             Show this screen.
       --version                             Show version.
       --prune                               Prune building faces.
-      --cache                               Save buildings.
+      --cache                               Reload the scene from a binary cache next to it, rebuilt when the scene or the options change.
       --input-format=<input_frmt>           Specify input format.
       --graphs                              Save the building facets dual graph.
+      --graph-format=<graph_format>         Dual graph format: sparse, dense or binary [default: sparse].
       --scene                               Sum and save the scene projection.
       --labels                              Save vector projections with error fields.
       --terrain                             Taking care of terrain.
+      --threads=<threads>                   Number of worker threads, 0 for all cores [default: 1].
+      --weld=<tolerance>                    Weld mesh points closer than the tolerance on load.
       --pixel-size=<size>                   Pixel size [default: 1].
+      --exact-raster                        Rasterize with exact pixel intersections instead of scanlines.
+      --sample-type=<type>                  Raster sample type: float64, float32, int16 or int32 [default: float64].
+      --height-scale=<scale>                Height of a raster sample unit [default: 1].
+      --height-offset=<offset>              Height of a zero raster sample [default: 0].
 )";
 
 struct Arguments
@@ -40,7 +49,10 @@ struct Arguments
         bool prune = false;
         bool cache = false;
         bool graphs = false;
+        city::io::AdjacencyFormat graph_format = city::io::AdjacencyFormat::sparse;
         bool terrain = false;
+        std::size_t threads = 1;
+        double weld_tolerance = city::scene::Scene::no_welding;
     };
     struct SavingArguments
     {
@@ -56,11 +68,18 @@ struct Arguments
     struct RasterizingArguments
     {
         double pixel_size = 0;
+        bool exact = false;
+        city::projection::SampleFormat format;
 
         bool rasterizing(void)
         {
             return static_cast<bool>(pixel_size);
         }
+
+        city::projection::Rasterization mode(void)
+        {
+            return exact ? city::projection::Rasterization::exact : city::projection::Rasterization::scanline;
+        }
     };
 
     Arguments(std::map<std::string, docopt::value> const& docopt_args)
@@ -72,7 +91,19 @@ struct Arguments
         scene_args.prune = docopt_args.at("--prune").asBool();
         scene_args.cache = docopt_args.at("--cache").asBool();
         scene_args.graphs = docopt_args.at("--graphs").asBool();
+        std::map<std::string, city::io::AdjacencyFormat> const graph_formats{{
+            {"sparse", city::io::AdjacencyFormat::sparse},
+            {"dense", city::io::AdjacencyFormat::dense},
+            {"binary", city::io::AdjacencyFormat::binary}
+        }};
+        auto graph_format = graph_formats.find(docopt_args.at("--graph-format").asString());
+        if(graph_format == std::end(graph_formats))
+            throw std::runtime_error("Unknown dual graph format: " + docopt_args.at("--graph-format").asString());
+        scene_args.graph_format = graph_format->second;
         scene_args.terrain = docopt_args.at("--terrain").asBool();
+        scene_args.threads = static_cast<std::size_t>(std::stoul(docopt_args.at("--threads").asString()));
+        if(docopt_args.at("--weld"))
+            scene_args.weld_tolerance = std::stod(docopt_args.at("--weld").asString());
         
         save_args.projections = docopt_args.at("save").asBool();
         if(save_args.projections)
@@ -82,7 +113,25 @@ struct Arguments
         }
 
         if(docopt_args.at("rasterize").asBool())
+        {
             raster_args.pixel_size = std::stod(docopt_args.at("--pixel-size").asString());
+            raster_args.exact = docopt_args.at("--exact-raster").asBool();
+
+            std::map<std::string, city::projection::SampleType> const sample_types{{
+                {"float64", city::projection::SampleType::float64},
+                {"float32", city::projection::SampleType::float32},
+                {"int16", city::projection::SampleType::int16},
+                {"int32", city::projection::SampleType::int32}
+            }};
+            auto sample_type = sample_types.find(docopt_args.at("--sample-type").asString());
+            if(sample_type == std::end(sample_types))
+                throw std::runtime_error("Unknown raster sample type: " + docopt_args.at("--sample-type").asString());
+            raster_args.format = city::projection::SampleFormat(
+                sample_type->second,
+                std::stod(docopt_args.at("--height-scale").asString()),
+                std::stod(docopt_args.at("--height-offset").asString())
+            );
+        }
         
         std::cout << "Done." << std::flush << std::endl;
     }
@@ -100,34 +149,81 @@ inline std::ostream & operator <<(std::ostream & os, Arguments & arguments)
        << "  Input path: " << arguments.scene_args.input_path << std::endl
        << "  Input format: " << arguments.scene_args.input_format << std::endl
        << "  Pruning faces: " << arguments.scene_args.prune << std::endl
-       << "  Caching buildings: " << arguments.scene_args.cache << std::endl
+       << "  Caching the scene: " << arguments.scene_args.cache << std::endl
        << "  Taking care of terrain: " << arguments.scene_args.terrain << std::endl
        << "  Saving dual graphs: " << arguments.scene_args.graphs << std::endl
+       << "  Dual graph format: " << (arguments.scene_args.graph_format == city::io::AdjacencyFormat::dense ? "dense" : arguments.scene_args.graph_format == city::io::AdjacencyFormat::binary ? "binary" : "sparse") << std::endl
+       << "  Worker threads: " << arguments.scene_args.threads << std::endl
+       << "  Welding tolerance: " << arguments.scene_args.weld_tolerance << std::endl
        << "  Saving: " << arguments.save_args.saving() << std::endl
        << "     Saving projections: " << arguments.save_args.projections << std::endl
        << "     Summing over whole scene: " << arguments.save_args.scene << std::endl
        << "     Saving projection error fields: " << arguments.save_args.labels << std::endl
        << "  Rasterizing: " << arguments.raster_args.rasterizing() << std::endl
-       << "     Pixel size: " << arguments.raster_args.pixel_size << std::endl;
+       << "     Pixel size: " << arguments.raster_args.pixel_size << std::endl
+       << "     Exact rasterization: " << arguments.raster_args.exact << std::endl
+       << "     Sample scale and offset: " << arguments.raster_args.format.scale << " " << arguments.raster_args.format.offset << std::endl;
     return os;
 }
 
 
 city::scene::Scene input_scene(Arguments::SceneArguments const& scene_args)
 {
-    auto scene = city::io::SceneHandler(
-        scene_args.input_path,
-        std::map<std::string, bool>{{"read", true}},
-        scene_args.input_format
-    ).read();
-
-    if(scene_args.prune)
-        scene = scene.prune(scene_args.terrain);
+    city::scene::Scene scene;
+
+    /* A cache is only reused when it was built from the same scene files, read and pruned the same way */
+    boost::filesystem::path cache_path(scene_args.input_path);
+    cache_path.replace_extension(city::io::SceneHandler::extension(city::io::SceneFormat::cache));
+    city::io::SceneCacheSource source{};
+    bool cached(false);
+    if(scene_args.cache)
+    {
+        source = city::io::SceneCacheSource::stamp(
+            scene_args.input_path,
+            static_cast<std::uint32_t>(city::io::SceneHandler::scene_format(scene_args.input_format)),
+            scene_args.weld_tolerance
+        );
+        if(boost::filesystem::is_regular_file(cache_path))
+        {
+            std::cout << "Mapping the scene cache... " << std::flush;
+            auto cache = city::io::SceneCacheHandler(cache_path, std::map<std::string, bool>{{"read", true}}).read();
+            cached = cache.source() == source && cache.pruned_buildings() == scene_args.prune && cache.pruned_terrain() == (scene_args.prune && scene_args.terrain);
+            if(cached)
+            {
+                scene = cache.to_scene(scene_args.threads);
+                std::cout << "Done." << std::flush << std::endl;
+            }
+            else
+                std::cout << "The cache is out of date, it will be rebuilt." << std::flush << std::endl;
+        }
+    }
+
+    if(!cached)
+    {
+        scene = city::io::SceneHandler(
+            scene_args.input_path,
+            std::map<std::string, bool>{{"read", true}},
+            scene_args.input_format,
+            scene_args.threads,
+            scene_args.weld_tolerance
+        ).read();
+
+        if(scene_args.prune)
+            scene = scene.prune(scene_args.terrain, scene_args.threads);
+
+        if(scene_args.cache)
+        {
+            std::cout << "Saving the scene cache... " << std::flush;
+            city::io::SceneCacheHandler(cache_path, std::map<std::string, bool>{{"write", true}}).write(scene, scene_args.prune, scene_args.terrain, source);
+            std::cout << "Done." << std::flush << std::endl;
+        }
+    }
     
     if(scene_args.graphs)
         city::save_building_duals(
             scene_args.input_path.parent_path(),
-            scene
+            scene,
+            scene_args.graph_format
         );
     return scene;
 }
@@ -153,24 +249,28 @@ int main(int argc, const char** argv)
 
         if(arguments.save_args.saving())
         {
-            auto projections = city::orthoproject(scene, arguments.scene_args.terrain);
+            auto projections = city::orthoproject(scene, arguments.scene_args.terrain, arguments.scene_args.threads);
 
             city::save_building_prints(data_directory, projections, arguments.save_args.labels);
 
+            if(arguments.raster_args.rasterizing())
+            {
+                auto raster_projections = city::rasterize_scene(projections, arguments.raster_args.pixel_size, arguments.raster_args.mode(), arguments.scene_args.threads, arguments.raster_args.format);
+                city::save_building_rasters(data_directory, raster_projections);
+            }
+
+            /* Last use of the building footprints: they are moved into the scene sum */
             if(arguments.save_args.scene)
                 city::save_scene_prints(
                     data_directory,
                     arguments.scene_args.input_path.stem().string(),
-                    projections,
+                    std::move(projections),
                     arguments.raster_args.rasterizing(),
-                    arguments.raster_args.pixel_size
+                    arguments.raster_args.pixel_size,
+                    arguments.scene_args.threads,
+                    arguments.raster_args.mode(),
+                    arguments.raster_args.format
                 );
-                    
-            if(arguments.raster_args.rasterizing())
-            {
-                auto raster_projections = city::rasterize_scene(projections, arguments.raster_args.pixel_size);
-                city::save_building_rasters(data_directory, raster_projections);
-            }
         }
     }
     catch(std::exception const& except)
@@ -5,4 +5,6 @@
 #include <algorithms/io_algorithms.h>
 
 #include <algorithms/util_algorithms.h>
+#include <algorithms/parallel_algorithms.h>
+#include <algorithms/raster_algorithms.h>
 #include <algorithms/test_utils.h>
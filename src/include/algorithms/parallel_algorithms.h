@@ -0,0 +1,173 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+
+#include <ostream>
+#include <string>
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace city
+{
+    /**
+     * Number of concurrent threads supported by the machine.
+     * @return the number of hardware threads, at least 1
+     */
+    inline std::size_t hardware_workers(void)
+    {
+        return std::max(std::size_t(1), static_cast<std::size_t>(std::thread::hardware_concurrency()));
+    }
+
+    /**
+     * Resolves a requested number of workers.
+     * @param workers requested number of workers, 0 meaning all hardware threads
+     * @return the effective number of workers
+     */
+    inline std::size_t resolve_workers(std::size_t const workers)
+    {
+        return workers == 0 ? hardware_workers() : workers;
+    }
+
+    /**
+     * @brief Thread safe progress counter printing `label done/total` on a single console line.
+     *
+     * The line is rewritten at most a hundred times, so that counting tens of thousands of work items does not flood the output.
+     */
+    class ProgressCounter
+    {
+    public:
+        /**
+         * Constructor
+         * @param _label text printed before the counter
+         * @param _total number of work items
+         * @param _os output stream of the counter
+         */
+        ProgressCounter(std::string const& _label, std::size_t const _total, std::ostream & _os)
+            : label(_label), total(_total), step(std::max(std::size_t(1), _total / 100)), done(0), printed(0), os(_os)
+        {
+            os << label << 0 << '/' << total << ' ' << std::flush;
+        }
+
+        /**
+         * Counts one finished work item.
+         */
+        void operator ()(void)
+        {
+            std::size_t const current = ++done;
+            if(current % step == 0 || current == total)
+                print(current);
+        }
+
+        /**
+         * Access the number of finished work items
+         * @return the number of finished work items
+         */
+        std::size_t count(void) const noexcept
+        {
+            return done;
+        }
+    private:
+        std::string label;
+        std::size_t total;
+        std::size_t step;
+        std::atomic<std::size_t> done;
+        /** last printed count, the counter never goes backwards on screen */
+        std::size_t printed;
+        std::ostream & os;
+        std::mutex os_mutex;
+
+        void print(std::size_t const current)
+        {
+            std::lock_guard<std::mutex> lock(os_mutex);
+            if(current <= printed)
+                return;
+            printed = current;
+            os << '\r' << label << current << '/' << total << ' ' << std::flush;
+        }
+    };
+
+    /**
+     * Calls `function` on every index in [0, size) using a bounded pool of threads.
+     * Indexes are handed out dynamically so that unbalanced work items do not starve the pool.
+     * The calling thread takes part in the work; with a single worker everything runs in order on it.
+     * The first exception thrown by `function` stops the distribution and is rethrown once all threads joined.
+     * @tparam Function callable taking a std::size_t index
+     * @param size number of work items
+     * @param function the work item
+     * @param workers number of threads, 0 meaning all hardware threads
+     */
+    template<typename Function>
+    void parallel_for(std::size_t const size, Function function, std::size_t const workers)
+    {
+        std::size_t const pool_size = std::min(resolve_workers(workers), size);
+        if(pool_size <= 1)
+        {
+            for(std::size_t index(0); index != size; ++index)
+                function(index);
+            return;
+        }
+
+        std::atomic<std::size_t> next(0);
+        std::exception_ptr failure;
+        std::mutex failure_mutex;
+
+        auto work = [size, &function, &next, &failure, &failure_mutex](void)
+        {
+            for(std::size_t index = next++; index < size; index = next++)
+            {
+                try
+                {
+                    function(index);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(failure_mutex);
+                    if(!failure)
+                        failure = std::current_exception();
+                    next = size;
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(pool_size - 1);
+        for(std::size_t worker(1); worker != pool_size; ++worker)
+            pool.emplace_back(work);
+        work();
+        for(auto & thread : pool)
+            thread.join();
+
+        if(failure)
+            std::rethrow_exception(failure);
+    }
+
+    /**
+     * Parallel counterpart of std::transform over random access ranges.
+     * Results are written at the position of their input so the output order is deterministic.
+     * @param first beginning of the input range
+     * @param last end of the input range
+     * @param d_first beginning of the output range
+     * @param operation unary operation applied to every input
+     * @param workers number of threads, 0 meaning all hardware threads
+     * @return iterator past the last written output
+     */
+    template<typename RandomIt, typename OutputIt, typename UnaryOperation>
+    OutputIt parallel_transform(RandomIt first, RandomIt last, OutputIt d_first, UnaryOperation operation, std::size_t const workers)
+    {
+        std::size_t const size = static_cast<std::size_t>(std::distance(first, last));
+        parallel_for(
+            size,
+            [first, d_first, &operation](std::size_t const index)
+            {
+                *std::next(d_first, static_cast<long>(index)) = operation(*std::next(first, static_cast<long>(index)));
+            },
+            workers
+        );
+        return std::next(d_first, static_cast<long>(size));
+    }
+}
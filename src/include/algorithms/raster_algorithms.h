@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+namespace city
+{
+    /**
+     * Adds a plane row to a running mean raster row.
+     * The height of the k-th pixel is `z_first + (first_column + k) * z_step`; each pixel becomes
+     * `(image[k] * hits[k] + z) / (hits[k] + 1)` and its hit count is incremented.
+     * Uses AVX2 when the processor supports it and falls back to the scalar kernel otherwise.
+     * Both kernels give the same results bit for bit.
+     * Heights only depend on the absolute column of a pixel, so a row gives the same heights however it is split in spans.
+     * @param image first pixel of the row span
+     * @param hits hit counts of the row span
+     * @param count number of pixels in the span
+     * @param z_first height of the first pixel
+     * @param z_step height increment between consecutive pixels
+     * @param first_column column of the first pixel of the span, `z_first` being the height of column 0
+     */
+    void accumulate_plane_row(double* image, short* hits, std::size_t const count, double const z_first, double const z_step, std::size_t const first_column = 0);
+
+    /**
+     * Scalar reference of `accumulate_plane_row`.
+     * @param image first pixel of the row span
+     * @param hits hit counts of the row span
+     * @param count number of pixels in the span
+     * @param z_first height of the first pixel
+     * @param z_step height increment between consecutive pixels
+     * @param first_column column of the first pixel of the span, `z_first` being the height of column 0
+     */
+    void accumulate_plane_row_scalar(double* image, short* hits, std::size_t const count, double const z_first, double const z_step, std::size_t const first_column = 0);
+
+    /**
+     * Tells whether `accumulate_plane_row` runs the AVX2 kernel on this machine.
+     * @return true if AVX2 is used
+     */
+    bool vectorized_plane_rows(void);
+}
@@ -8,11 +8,43 @@
 
 namespace city
 {
-    void save_building_duals(boost::filesystem::path const& root_path, scene::Scene const& scene);
+    void save_building_duals(boost::filesystem::path const& root_path, scene::Scene const& scene, io::AdjacencyFormat const format = io::AdjacencyFormat::sparse);
     void save_building_prints(boost::filesystem::path const& root_path, std::vector<projection::FootPrint> const& projections, bool const labels);
     void save_building_rasters(boost::filesystem::path const& root_path, std::vector<projection::RasterPrint> const& raster_projections);
-    void save_scene_prints(boost::filesystem::path const& root_path, std::string const& filename, std::vector<projection::FootPrint> const& projections, bool const rasterize, double const pixel_size);
+    /**
+     * Sums the footprints and saves the scene footprint, and optionally its raster.
+     * @param projections the footprints to sum, moved into the reduction
+     */
+    void save_scene_prints(boost::filesystem::path const& root_path, std::string const& filename, std::vector<projection::FootPrint> && projections, bool const rasterize, double const pixel_size, std::size_t const workers = 1, projection::Rasterization const mode = projection::Rasterization::exact, projection::SampleFormat const& format = projection::SampleFormat());
 
-    std::vector<projection::FootPrint> orthoproject(scene::Scene const& scene, bool const terrain);
-    std::vector<projection::RasterPrint> rasterize_scene(std::vector<projection::FootPrint> const& projections, double const  pixel_size);
+    /**
+     * Sums footprints with a pairwise tree reduction.
+     * Footprints are first ordered along a space filling curve so that neighbouring buildings are merged together,
+     * then each level of the tree merges independent pairs concurrently.
+     * Each pair keeps the name of the footprint that comes first in `projections`.
+     * @param projections the footprints to sum, moved into the reduction
+     * @param workers number of threads, 0 meaning all hardware threads
+     * @return the footprint of the whole scene
+     */
+    projection::FootPrint sum_prints(std::vector<projection::FootPrint> && projections, std::size_t const workers = 1);
+
+    /**
+     * Projects every building, and optionally the terrain, on the horizontal plane.
+     * Buildings are independent so they are projected concurrently; the output keeps the scene order.
+     * @param scene the scene to project
+     * @param terrain whether to append the terrain projection
+     * @param workers number of threads, 0 meaning all hardware threads
+     * @return the building footprints followed by the terrain footprint if asked
+     */
+    std::vector<projection::FootPrint> orthoproject(scene::Scene const& scene, bool const terrain, std::size_t const workers = 1);
+    /**
+     * Rasterizes every footprint; footprints are independent so they are rasterized concurrently.
+     * @param projections the footprints to rasterize
+     * @param pixel_size pixel size
+     * @param mode rasterization algorithm
+     * @param workers number of threads, 0 meaning all hardware threads
+     * @param format sample format used when the rasters are saved
+     * @return the rasters, in the footprints order
+     */
+    std::vector<projection::RasterPrint> rasterize_scene(std::vector<projection::FootPrint> const& projections, double const  pixel_size, projection::Rasterization const mode = projection::Rasterization::exact, std::size_t const workers = 1, projection::SampleFormat const& format = projection::SampleFormat());
 }
@@ -48,4 +48,12 @@ namespace city
     
     std::vector<double> edge_lengths(Polygon const& polygon);
     double circumference(Polygon const& polygon);
+
+    /**
+     * Orders bounding boxes along a Z-order (Morton) curve of their centers.
+     * Neighbouring positions in the returned order are spatially close; empty boxes come first.
+     * @param boxes the bounding boxes to order
+     * @return box positions sorted along the curve
+     */
+    std::vector<std::size_t> spatial_order(std::vector<Bbox_2> const& boxes);
 }
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <scene/facet_graph.h>
+
+#include <io/Buffered_stream/buffered_stream.h>
+
+#include <istream>
 #include <ostream>
 
 #include <vector>
 #include <iterator>
+#include <algorithm>
 
 #include <cmath>
 
@@ -13,6 +19,17 @@ namespace city
 {
     namespace io
     {
+        /** Adjacency output format */
+        enum class AdjacencyFormat
+        {
+            /** One `i j` line per pair of adjacent facets, with i < j */
+            sparse,
+            /** Full adjacency matrix, diagonal included */
+            dense,
+            /** Binary dual graph file, written by DualGraphHandler rather than by this stream */
+            binary
+        };
+
         /**
          * @ingroup io
          * @brief formats an output stream to write graph adjacency matrices
@@ -23,11 +40,12 @@ namespace city
             /**
             * Reference constructor
             * @param _ios reference to input/output stream
+            * @param _format format of the graphs written to the stream
             * @see Adjacency_stream(std::iostream && _ios)
             * @see Adjacency_stream(Adjacency_stream & _ios)
             * @see Adjacency_stream(Adjacency_stream && _ios)
             */
-            Adjacency_stream(std::iostream & _ios): ios(_ios) {}
+            Adjacency_stream(std::iostream & _ios, AdjacencyFormat const _format = AdjacencyFormat::sparse): ios(_ios), format(_format) {}
             /**
             * Copy constructor
             * @param other reference to Adjacency stream
@@ -35,7 +53,7 @@ namespace city
             * @see Adjacency_stream(std::iostream && _ios)
             * @see Adjacency_stream(Adjacency_stream && other)
             */
-            Adjacency_stream(Adjacency_stream & other): ios(other.ios) {}
+            Adjacency_stream(Adjacency_stream & other): ios(other.ios), format(other.format) {}
 
             /**
             * Defines operator << for this stream.
@@ -61,15 +79,59 @@ namespace city
                 if(n * n != matrix.size())
                     throw std::logic_error("The adjacency matrix must be square!");
 
+                Buffered_stream out(ios);
                 for(std::size_t row(0); row != n; ++row)
                 {
                     for(std::size_t col(0); col != n - 1; ++col)
-                        ios << matrix.at(row * n + col) << " ";
-                    ios << matrix.at(row * n + (n-1)) << std::endl;
+                        out << matrix[row * n + col] << ' ';
+                    out << matrix[row * n + (n-1)] << '\n';
                 }
                 return *this;
             }
 
+            /**
+            * Defines operator << for a facet graph, written in the format of the stream.
+            * @param graph graph to output
+            * @return reference to the Adjacency_stream
+            */
+            Adjacency_stream & operator <<(scene::FacetGraph const& graph)
+            {
+                if(format == AdjacencyFormat::binary)
+                    throw std::logic_error("Binary dual graphs are written by DualGraphHandler!");
+                if(format == AdjacencyFormat::dense)
+                    return *this << graph.dense();
+
+                Buffered_stream out(ios);
+                for(std::size_t row(0); row != graph.size(); ++row)
+                    std::for_each(
+                        graph.neighbours_cbegin(row),
+                        graph.neighbours_cend(row),
+                        [&out, row](std::size_t const column)
+                        {
+                            if(row < column)
+                                out << row << ' ' << column << '\n';
+                        }
+                    );
+                return *this;
+            }
+
+            /**
+            * Writes row major attributes, one row per line.
+            * @param attributes attribute values
+            * @param columns number of values per row
+            * @return reference to the Adjacency_stream
+            */
+            Adjacency_stream & print_rows(std::vector<double> const& attributes, std::size_t const columns)
+            {
+                if(columns == 0 || attributes.size() % columns != 0)
+                    throw std::logic_error("The attributes must fill whole rows!");
+
+                Buffered_stream out(ios);
+                for(std::size_t index(0); index != attributes.size(); ++index)
+                    out << attributes[index] << ((index + 1) % columns == 0 ? '\n' : ' ');
+                return *this;
+            }
+
             /**
             * Defines operator << for this stream.
             * @param func function applied to output stream
@@ -83,6 +145,8 @@ namespace city
         private:
             /** reference to an output stream */
             std::iostream & ios;
+            /** graph format */
+            AdjacencyFormat format;
         };
     }
 }
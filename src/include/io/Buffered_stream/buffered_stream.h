@@ -0,0 +1,251 @@
+#pragma once
+
+#include <ostream>
+
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <limits>
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+namespace city
+{
+    namespace io
+    {
+        /**
+         * @ingroup io
+         * @brief Buffers text output in user space and formats numbers without the iostream machinery.
+         *
+         * Text writers format lines into a large buffer that goes to the underlying stream only when it is full,
+         * on flush() and on destruction, instead of flushing on every line.
+         * Floating point numbers are printed with the fewest significant digits that read back to the same value, see shortest().
+         * Values of other types are written through the underlying stream after flushing the buffer, so that the output order is kept.
+         */
+        class Buffered_stream
+        {
+        public:
+            /**
+             * Reference constructor
+             * @param _os output stream receiving the buffer
+             * @param capacity buffer size in bytes
+             */
+            explicit Buffered_stream(std::ostream & _os, std::size_t const capacity = std::size_t(1) << 20)
+                : os(_os), buffer(std::max(capacity, std::size_t(64))), size(0)
+            {}
+            Buffered_stream(Buffered_stream const& other) = delete;
+            Buffered_stream & operator =(Buffered_stream const& other) = delete;
+            /**
+             * Destructor, writes the remaining buffer
+             */
+            ~Buffered_stream(void)
+            {
+                flush();
+            }
+
+            /**
+             * Writes the buffer to the underlying stream, without flushing the stream itself.
+             */
+            void flush(void)
+            {
+                if(size != 0)
+                    os.write(buffer.data(), static_cast<std::streamsize>(size));
+                size = 0;
+            }
+
+            /**
+             * Appends characters.
+             * @param text first character
+             * @param length number of characters
+             * @return reference to the Buffered_stream
+             */
+            Buffered_stream & write(char const* text, std::size_t const length)
+            {
+                if(length > buffer.size() - size)
+                {
+                    flush();
+                    if(length > buffer.size())
+                    {
+                        os.write(text, static_cast<std::streamsize>(length));
+                        return *this;
+                    }
+                }
+                std::memcpy(buffer.data() + size, text, length);
+                size += length;
+                return *this;
+            }
+
+            Buffered_stream & operator <<(char const character)
+            {
+                if(size == buffer.size())
+                    flush();
+                buffer[size++] = character;
+                return *this;
+            }
+            Buffered_stream & operator <<(char const* text)
+            {
+                return write(text, std::strlen(text));
+            }
+            Buffered_stream & operator <<(std::string const& text)
+            {
+                return write(text.data(), text.size());
+            }
+
+            /**
+             * Writes an integer in decimal.
+             * @tparam T integer type
+             * @param value value to output
+             * @return reference to the Buffered_stream
+             */
+            template<typename T>
+            typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value, Buffered_stream &>::type
+            operator <<(T const value)
+            {
+                char digits[std::numeric_limits<unsigned long long>::digits10 + 2];
+                char* first = digits + sizeof(digits);
+                bool const negative = value < T(0);
+                unsigned long long magnitude = negative ? 0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+                do
+                {
+                    *--first = static_cast<char>('0' + magnitude % 10);
+                    magnitude /= 10;
+                }while(magnitude != 0);
+                if(negative)
+                    *this << '-';
+                return write(first, static_cast<std::size_t>(digits + sizeof(digits) - first));
+            }
+
+            /**
+             * Writes a floating point number with the fewest significant digits reading back to it.
+             * @tparam T floating point type
+             * @param value value to output
+             * @return reference to the Buffered_stream
+             */
+            template<typename T>
+            typename std::enable_if<std::is_floating_point<T>::value, Buffered_stream &>::type
+            operator <<(T const value)
+            {
+                char text[32];
+                return write(text, shortest(static_cast<double>(value), text));
+            }
+
+            /**
+             * Writes any other value through the underlying stream.
+             * @tparam T output value type
+             * @param value value to output
+             * @return reference to the Buffered_stream
+             */
+            template<typename T>
+            typename std::enable_if<!std::is_arithmetic<T>::value, Buffered_stream &>::type
+            operator <<(T const& value)
+            {
+                flush();
+                os << value;
+                return *this;
+            }
+
+            /**
+             * Formats a double with the fewest significant digits that read back to the same value.
+             * The decimal candidates are `round(value * 10^d) / 10^d` while the scaled value is an exact integer,
+             * which covers every value with up to 15 significant digits and 22 decimals,
+             * the other values being written with 16 or 17 significant digits.
+             * @param value value to format
+             * @param text buffer of at least 32 characters
+             * @return the number of characters written
+             */
+            static std::size_t shortest(double const value, char* text)
+            {
+                for(std::size_t decimals(0); decimals != powers().size(); ++decimals)
+                {
+                    double const scaled = std::round(value * powers()[decimals]);
+                    if(!(std::fabs(scaled) < exact_integers))
+                        break;
+                    if(scaled / powers()[decimals] == value)
+                        return print_decimal(static_cast<long long>(scaled), decimals, text);
+                    /* Near 2^53, the rounding of the product can miss the closest candidate by one */
+                    if(std::fabs(scaled) >= exact_integers / 8)
+                        for(double const neighbour : {scaled - 1, scaled + 1})
+                            if(neighbour / powers()[decimals] == value)
+                                return print_decimal(static_cast<long long>(neighbour), decimals, text);
+                }
+                int length = std::snprintf(text, 32, "%.16g", value);
+                if(std::strtod(text, nullptr) != value)
+                    length = std::snprintf(text, 32, "%.17g", value);
+                return static_cast<std::size_t>(length);
+            }
+            /**
+             * Formats a double rounded to a number of decimals, without trailing zeros.
+             * Values too large to be scaled exactly, and non finite values, are formatted with shortest().
+             * @param value value to format
+             * @param decimals number of decimals, at most 9
+             * @param text buffer of at least 32 characters
+             * @return the number of characters written
+             */
+            static std::size_t fixed(double const value, std::size_t const decimals, char* text)
+            {
+                double const scaled = std::round(value * powers()[std::min(decimals, std::size_t(9))]);
+                if(!(std::fabs(scaled) < exact_integers))
+                    return shortest(value, text);
+                return print_decimal(static_cast<long long>(scaled), std::min(decimals, std::size_t(9)), text);
+            }
+        private:
+            /** reference to the output stream */
+            std::ostream & os;
+            /** characters waiting to be written */
+            std::vector<char> buffer;
+            /** number of characters in the buffer */
+            std::size_t size;
+
+            /** 2^53: integers below are exactly represented by doubles */
+            static constexpr double exact_integers = 9007199254740992.;
+
+            /** Powers of ten exactly represented by doubles */
+            static std::array<double, 23> const& powers(void) noexcept
+            {
+                static const std::array<double, 23> table{{
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                }};
+                return table;
+            }
+
+            /**
+             * Writes `mantissa * 10^-decimals` in decimal notation, without trailing zeros.
+             * @param mantissa scaled value
+             * @param decimals number of decimals in the mantissa
+             * @param text buffer of at least 32 characters
+             * @return the number of characters written
+             */
+            static std::size_t print_decimal(long long const mantissa, std::size_t decimals, char* text) noexcept
+            {
+                unsigned long long magnitude = mantissa < 0 ? 0ull - static_cast<unsigned long long>(mantissa) : static_cast<unsigned long long>(mantissa);
+                for(; decimals != 0 && magnitude % 10 == 0; --decimals)
+                    magnitude /= 10;
+
+                char digits[32];
+                char* first = digits + sizeof(digits);
+                for(std::size_t digit(0); digit != decimals; ++digit, magnitude /= 10)
+                    *--first = static_cast<char>('0' + magnitude % 10);
+                if(decimals != 0)
+                    *--first = '.';
+                do
+                {
+                    *--first = static_cast<char>('0' + magnitude % 10);
+                    magnitude /= 10;
+                }while(magnitude != 0);
+                if(mantissa < 0)
+                    *--first = '-';
+
+                std::size_t const length = static_cast<std::size_t>(digits + sizeof(digits) - first);
+                std::memcpy(text, first, length);
+                return length;
+            }
+        };
+    }
+}
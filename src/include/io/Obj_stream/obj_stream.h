@@ -1,20 +1,25 @@
 #pragma once
 
 #include <shadow/mesh.h>
+#include <shadow/flat_mesh.h>
 
-#include <io/Line/line.h>
+#include <io/Scanner/scanner.h>
+#include <io/Buffered_stream/buffered_stream.h>
+#include <io/Point_format/point_format.h>
 
 #include <algorithms/io_algorithms.h>
 
 #include <boost/range/combine.hpp>
 
+#include <istream>
 #include <ostream>
 
 #include <stdexcept>
 
 #include <vector>
-#include <deque>
+#include <string>
 #include <algorithm>
+#include <numeric>
 #include <iterator>
 #include <ios>
 
@@ -33,11 +38,12 @@ namespace city
             /**
             * Reference constructor
             * @param _ios reference to input/output stream
+            * @param decimals number of decimals of the written coordinates, or Point_format::round_trip
             * @see Obj_stream(std::ostream && _ios)
             * @see Obj_stream(Obj_stream & _ios)
             * @see Obj_stream(Obj_stream && _ios)
             */
-            Obj_stream(std::iostream & _ios): ios(_ios) {}
+            Obj_stream(std::iostream & _ios, int const decimals = Point_format::round_trip): ios(_ios), format(decimals) {}
             /**
             * Copy constructor
             * @param other reference to Adjacency stream
@@ -45,7 +51,7 @@ namespace city
             * @see Obj_stream(std::iostream && _ios)
             * @see Obj_stream(Obj_stream && other)
             */
-            Obj_stream(Obj_stream & other): ios(other.ios) {}
+            Obj_stream(Obj_stream & other): ios(other.ios), format(other.format) {}
             /**
             * Defines operator<< for this stream.
             * @tparam T output value type
@@ -106,8 +112,9 @@ namespace city
                     std::begin(shifts)
                 );
 
-                print_points(meshes);
-                print_faces(meshes, shifts);
+                Buffered_stream out(ios);
+                print_points(out, meshes);
+                print_faces(out, meshes, shifts);
 
                 return *this;
             }
@@ -118,232 +125,242 @@ namespace city
              */
             Obj_stream & operator >>(std::vector<shadow::Mesh> & meshes)
             {
-                auto lines = parse();
-
-                if (lines.empty())
-                    throw std::out_of_range("The stream contains only comments and/or empty lines!");
-
-                auto cursor = std::begin(lines);
-
-                auto points = read_points(lines, cursor);
-                
-                meshes = read_objects(lines, cursor, points);
+                std::string buffer{std::istreambuf_iterator<char>(ios.rdbuf()), std::istreambuf_iterator<char>()};
+                meshes = parse(buffer.data(), buffer.data() + buffer.size());
 
                 return *this;
             }
 
-        private:
-            /** reference to a stream */
-            std::iostream & ios;
-
-            void print_points(std::vector<shadow::Mesh> const& meshes)
-            {
-                for(auto const& mesh : meshes)
-                    print_mesh_points(mesh);
-            }
-            void print_mesh_points(shadow::Mesh const& mesh)
+            /**
+             * Parses meshes from an obj character buffer.
+             * @param first first character of the buffer
+             * @param last past the last character of the buffer
+             * @return the meshes, each with its own vertices
+             * @see parse_flat(char const* first, char const* last)
+             */
+            static std::vector<shadow::Mesh> parse(char const* first, char const* last)
             {
-                std::for_each(
-                    mesh.points_cbegin(),
-                    mesh.points_cend(),
-                    [this](shadow::Point const& points)
+                std::vector<shadow::FlatMesh> flat_meshes = parse_flat(first, last);
+                std::vector<shadow::Mesh> meshes(flat_meshes.size());
+                std::transform(
+                    std::begin(flat_meshes),
+                    std::end(flat_meshes),
+                    std::begin(meshes),
+                    [](shadow::FlatMesh const& flat_mesh)
                     {
-                        ios << "v " << points << std::endl;
+                        return flat_mesh.to_mesh();
                     }
                 );
+                return meshes;
             }
-            void print_faces(std::vector<shadow::Mesh> const& meshes, std::vector<std::size_t> const& shifts)
-            {
-                for(auto const& mesh_shift : boost::combine(meshes, shifts))
-                    print_mesh_faces(mesh_shift.get<0>(), mesh_shift.get<1>());
-            }
-            void print_mesh_faces(shadow::Mesh const& mesh, std::size_t const shift)
+            /**
+             * Parses flat meshes from an obj character buffer in a single pass.
+             * The buffer can be a memory-mapped file: it is neither copied nor split in lines.
+             *  - `v` lines are global vertices, `o` lines start objects and `f` lines add facets to the current object,
+             *  - texture and normal indices of `f` lines are ignored and negative indices are relative to the last vertex,
+             *  - other lines, and facets before the first object, are skipped.
+             * Meshes are sorted by name, only the first object of a name being kept.
+             * @param first first character of the buffer
+             * @param last past the last character of the buffer
+             * @return the meshes, each with its own vertices, filled without any allocation per point or per facet
+             */
+            static std::vector<shadow::FlatMesh> parse_flat(char const* first, char const* last)
             {
-                ios << std::endl;
-                ios << "o " << mesh.get_name() << std::endl;
+                Scanner scanner(first, last);
 
-                std::for_each(
-                    mesh.faces_cbegin(),
-                    mesh.faces_cend(),
-                    [this, shift](shadow::Face const& facet)
+                std::vector<shadow::Point> points;
+                std::vector<Object> objects;
+                bool content(false);
+                std::vector<double> coordinates;
+                coordinates.reserve(4);
+
+                for(scanner.skip_whitespaces(); !scanner.at_end(); scanner.skip_whitespaces())
+                {
+                    if(scanner.peek() != '#')
                     {
-                        ios << "f ";
-                        for(auto const index: facet)
-                            ios << index + shift + 1 << " ";
-                        ios << std::endl;
+                        content = true;
+                        std::string keyword = scanner.read_word();
+                        if(keyword == "v")
+                        {
+                            coordinates.clear();
+                            double coordinate(0);
+                            while(coordinates.size() != 4 && scanner.read_double(coordinate))
+                                coordinates.push_back(coordinate);
+                            points.push_back(to_point(coordinates));
+                        }
+                        else if(keyword == "o")
+                            objects.push_back(Object(scanner.read_word()));
+                        else if(keyword == "f" && !objects.empty())
+                            read_facet(scanner, objects.back(), points.size());
                     }
-                );
-            }
+                    scanner.skip_line();
+                }
 
-            std::deque<std::string> parse(void)
-            {
-                std::deque<std::string> lines;
-                readlines(ios, std::back_inserter(lines));
-
-                /*Ignore Comments*/
-                lines.erase(
-                    std::remove_if(
-                        std::begin(lines),
-                        std::end(lines),
-                        [](std::string const& line)
+                if(!content)
+                    throw std::out_of_range("The stream contains only comments and/or empty lines!");
+
+                std::stable_sort(
+                    std::begin(objects),
+                    std::end(objects),
+                    [](Object const& lhs, Object const& rhs)
+                    {
+                        return lhs.name < rhs.name;
+                    }
+                );
+                objects.erase(
+                    std::unique(
+                        std::begin(objects),
+                        std::end(objects),
+                        [](Object const& lhs, Object const& rhs)
                         {
-                            return line.empty() || line.at(0) == '#';
+                            return lhs.name == rhs.name;
                         }
                     ),
-                    std::end(lines)
+                    std::end(objects)
                 );
 
-                return lines;
-            }
-
-            std::vector<shadow::Point> read_points(std::deque<std::string> const& lines, std::deque<std::string>::iterator & cursor)
-            {
-                /*
-                   It is initialized by the origin:
-                    - it corresponds to the pivot
-                    - and `obj' point indexes starts at 1.
-                */
-                std::vector<shadow::Point> points(1);
-                points.reserve(lines.size() / 2);
-
-                for(; cursor != std::end(lines) && cursor->front() == 'v'; ++cursor)
-                    points.push_back(
-                        ::city::line2pt(cursor->substr(1))
-                    );
+                /* Flat global to local index remap, reset after each object */
+                std::vector<std::size_t> index_map(points.size(), std::size_t(unmapped));
+                std::vector<shadow::FlatMesh> meshes;
+                meshes.reserve(objects.size());
+                for(auto const& object : objects)
+                    meshes.push_back(read_object(object, points, index_map));
 
-                return points;
+                return meshes;
             }
 
-            std::vector<shadow::Mesh> read_objects(std::deque<std::string> const& lines, std::deque<std::string>::iterator & cursor, std::vector<shadow::Point> const& points)
+        private:
+            /** reference to a stream */
+            std::iostream & ios;
+            /** coordinate format */
+            Point_format format;
+
+            /** Obj object as parsed: facets are flattened global vertex indexes */
+            struct Object
             {
-                auto objects = object_names(lines, cursor);
+                Object(std::string const& _name): name(_name) {}
 
-                std::vector<shadow::Mesh> meshes(objects.size());
+                std::string name;
+                std::vector<std::size_t> indexes;
+                std::vector<std::size_t> sizes;
+            };
 
-                std::transform(
-                    std::begin(objects),
-                    std::end(objects),
-                    std::begin(meshes),
-                    [&lines, &points, this](std::pair<std::string, std::pair<std::size_t, size_t> > const& object_id)
-                    {
-                        return read_object(lines, points, object_id.first, object_id.second.first, object_id.second.second);
-                    }
-                );
+            static const std::size_t unmapped = static_cast<std::size_t>(-1);
 
-                return meshes;
+            static shadow::Point to_point(std::vector<double> & coordinates)
+            {
+                if(coordinates.size() == 4)
+                {
+                    if(!static_cast<bool>(coordinates[3]))
+                        throw std::logic_error("Not implemented in this scope!");
+                    coordinates = std::vector<double>{{coordinates[0] / coordinates[3], coordinates[1] / coordinates[3], coordinates[2] / coordinates[3]}};
+                }
+                return ::city::str2pt(coordinates);
             }
 
-            shadow::Mesh read_object(std::deque<std::string> const& lines, std::vector<shadow::Point> const& points, std::string const& name, std::size_t const index, std::size_t const number_of_facets)
+            static void read_facet(Scanner & scanner, Object & object, std::size_t const number_of_points)
             {
-                std::map<std::size_t, std::size_t> index_map;
-                std::vector<shadow::Face> facets = read_facets(lines, index, number_of_facets, index_map);
+                std::size_t size(0);
+                long index(0);
+                while(scanner.read_integer(index))
+                {
+                    if(index == 0 || (index < 0 && static_cast<std::size_t>(-index) > number_of_points))
+                        throw std::out_of_range("Invalid obj vertex index!");
+                    object.indexes.push_back(
+                        index > 0
+                            ? static_cast<std::size_t>(index - 1)
+                            : number_of_points - static_cast<std::size_t>(-index)
+                    );
+                    ++size;
 
-                return shadow::Mesh(name, ::city::select(points, index_map), facets);
+                    /* Skip texture and normal indexes */
+                    while(!scanner.at_line_end() && scanner.peek() != ' ' && scanner.peek() != '\t' && scanner.peek() != '\r')
+                        scanner.advance();
+                }
+                /* Anything else than a comment left on the line is an index that could not be read, such as one overflowing a long */
+                scanner.skip_blanks();
+                if(!scanner.at_line_end() && scanner.peek() != '#')
+                    throw std::out_of_range("Invalid obj vertex index!");
+                object.sizes.push_back(size);
             }
 
-            std::vector<shadow::Face> read_facets(std::deque<std::string> const& lines, std::size_t const index, std::size_t const number_of_facets, std::map<std::size_t, std::size_t> & index_map)
+            static shadow::FlatMesh read_object(Object const& object, std::vector<shadow::Point> const& points, std::vector<std::size_t> & index_map)
             {
-                std::vector<shadow::Face> object_faces(number_of_facets);
-
+                std::vector<std::size_t> selected;
+                std::vector<std::size_t> local_indexes(object.indexes.size());
                 std::transform(
-                    std::next(std::begin(lines), static_cast<long>(index)),
-                    std::next(std::begin(lines), static_cast<long>(index) + static_cast<long>(number_of_facets)),
-                    std::begin(object_faces),
-                    [&index_map, this](std::string const& facet_line)
+                    std::begin(object.indexes),
+                    std::end(object.indexes),
+                    std::begin(local_indexes),
+                    [&index_map, &selected, &points](std::size_t const index)
                     {
-                        return read_facet(facet_line.substr(1), index_map);
+                        if(index >= points.size())
+                            throw std::out_of_range("Invalid obj vertex index!");
+                        if(index_map[index] == unmapped)
+                        {
+                            index_map[index] = selected.size();
+                            selected.push_back(index);
+                        }
+                        return index_map[index];
                     }
                 );
 
-                return object_faces;
-            }
-
-            shadow::Face read_facet(std::string const& line, std::map<std::size_t, std::size_t> & index_map)
-            {
-                std::istringstream buffer_line(line);
-
-                std::deque<std::size_t> indexes;
+                shadow::FlatMesh mesh(object.name);
+                mesh.reserve(selected.size(), object.sizes.size(), local_indexes.size());
+                for(auto const index : selected)
+                {
+                    index_map[index] = unmapped;
+                    mesh.add_point(points[index]);
+                }
 
-                std::copy(
-                    std::istream_iterator<double>(buffer_line),
-                    std::istream_iterator<double>(),
-                    std::back_inserter(indexes)
-                );
+                auto cursor = std::begin(local_indexes);
+                for(auto const size : object.sizes)
+                {
+                    auto next = std::next(cursor, static_cast<long>(size));
+                    mesh.add_face(cursor, next);
+                    cursor = next;
+                }
 
-                auto maped_index = index_map.size();
-                for(auto index : indexes)
-                    if(!static_cast<bool>(index_map.count(index)))
-                        index_map.emplace(std::make_pair(index, maped_index++));
+                return mesh;
+            }
 
-                std::vector<std::size_t> new_indexes(indexes.size());
-                std::transform(
-                    std::begin(indexes),
-                    std::end(indexes),
-                    std::begin(new_indexes),
-                    [&index_map](std::size_t const index)
+            void print_points(Buffered_stream & out, std::vector<shadow::Mesh> const& meshes)
+            {
+                for(auto const& mesh : meshes)
+                    print_mesh_points(out, mesh);
+            }
+            void print_mesh_points(Buffered_stream & out, shadow::Mesh const& mesh)
+            {
+                std::for_each(
+                    mesh.points_cbegin(),
+                    mesh.points_cend(),
+                    [this, &out](shadow::Point const& point)
                     {
-                        return index_map[index];
+                        format.write(out << "v ", point) << '\n';
                     }
                 );
-                return shadow::Face(new_indexes);
             }
-
-            std::map<std::string, std::pair<std::size_t, std::size_t> > object_names(std::deque<std::string> const& lines, std::deque<std::string>::iterator & cursor)
+            void print_faces(Buffered_stream & out, std::vector<shadow::Mesh> const& meshes, std::vector<std::size_t> const& shifts)
             {
-                std::map<std::string, std::pair<std::size_t, std::size_t> > objects;
-
-                std::stringstream buffer;
-
-                std::deque<std::string> names;
-                std::deque<std::size_t> indexes;
-                for(; cursor != std::end(lines); ++cursor)
-                {
-                    if(cursor->front() == 'o')
-                    {
-                        buffer.str(cursor->substr(1));
-                        std::string name("");
-                        buffer >> name;
-                        names.push_back(name);
-                        indexes.push_back(
-                            static_cast<std::size_t>(
-                                std::distance<std::deque<std::string>::const_iterator>(
-                                    std::begin(lines),
-                                    cursor
-                                )
-                            ) + 1
-                        );
-                        buffer.clear();
-                    }
-                }
-                indexes.push_back(lines.size() + 1);
-
-                std::vector< std::size_t > sizes(indexes.size());
+                for(auto const& mesh_shift : boost::combine(meshes, shifts))
+                    print_mesh_faces(out, mesh_shift.get<0>(), mesh_shift.get<1>());
+            }
+            void print_mesh_faces(Buffered_stream & out, shadow::Mesh const& mesh, std::size_t const shift)
+            {
+                out << '\n'
+                    << "o " << mesh.get_name() << '\n';
 
-                std::adjacent_difference(
-                    indexes.rbegin(),
-                    indexes.rend(),
-                    sizes.rbegin(),
-                    [](std::size_t const lhs, std::size_t const rhs)
+                std::for_each(
+                    mesh.faces_cbegin(),
+                    mesh.faces_cend(),
+                    [&out, shift](shadow::Face const& facet)
                     {
-                        return rhs - lhs -1;
+                        out << "f ";
+                        for(auto const index: facet)
+                            out << index + shift + 1 << ' ';
+                        out << '\n';
                     }
                 );
-
-                sizes.pop_back();
-                indexes.pop_back();
-
-                for(auto const& name_size_index : boost::combine(names, sizes, indexes))
-                    objects.emplace( 
-                        std::make_pair(
-                            name_size_index.get<0>(),
-                            std::make_pair(
-                                name_size_index.get<2>(),
-                                name_size_index.get<1>()
-                            )
-                        )
-                    );
-                    
-                return objects;
             }
         };
     }
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <shadow/mesh.h>
+#include <shadow/flat_mesh.h>
 
-#include <io/Line/line.h>
+#include <io/Scanner/scanner.h>
+#include <io/Buffered_stream/buffered_stream.h>
+#include <io/Point_format/point_format.h>
 
+#include <istream>
 #include <ostream>
 
 #include <stdexcept>
 
 #include <vector>
+#include <string>
 #include <algorithm>
 #include <iterator>
 
@@ -27,11 +32,12 @@ namespace city
             /**
             * Reference constructor
             * @param _ios reference to input/output stream
+            * @param decimals number of decimals of the written coordinates, or Point_format::round_trip
             * @see Off_stream(std::ostream && _ios)
             * @see Off_stream(Off_stream & _ios)
             * @see Off_stream(Off_stream && _ios)
             */
-            Off_stream(std::iostream & _ios): ios(_ios) {}
+            Off_stream(std::iostream & _ios, int const decimals = Point_format::round_trip): ios(_ios), format(decimals) {}
             /**
             * Copy constructor
             * @param other reference to Adjacency stream
@@ -39,7 +45,7 @@ namespace city
             * @see Off_stream(std::iostream && _ios)
             * @see Off_stream(Off_stream && other)
             */
-            Off_stream(Off_stream & other): ios(other.ios) {}
+            Off_stream(Off_stream & other): ios(other.ios), format(other.format) {}
             /**
             * Defines operator<< for this stream.
             * @tparam T output value type
@@ -84,9 +90,10 @@ namespace city
              */
             Off_stream & operator <<(shadow::Mesh const& mesh)
             {
-                print_header(mesh);
-                print_points(mesh);
-                print_faces(mesh);
+                Buffered_stream out(ios);
+                print_header(out, mesh);
+                print_points(out, mesh);
+                print_faces(out, mesh);
 
                 return *this;
             }
@@ -97,171 +104,150 @@ namespace city
              */
             Off_stream & operator >>(shadow::Mesh & mesh)
             {
-                auto lines = parse();
+                std::string buffer{std::istreambuf_iterator<char>(ios.rdbuf()), std::istreambuf_iterator<char>()};
+                mesh = parse(buffer.data(), buffer.data() + buffer.size());
 
-                if (lines.empty())
+                return *this;
+            }
+
+            /**
+             * Parses a mesh from an off character buffer.
+             * @param first first character of the buffer
+             * @param last past the last character of the buffer
+             * @return the mesh
+             * @see parse_flat(char const* first, char const* last)
+             */
+            static shadow::Mesh parse(char const* first, char const* last)
+            {
+                return parse_flat(first, last).to_mesh();
+            }
+            /**
+             * Parses a flat mesh from an off character buffer in a single forward pass.
+             * The buffer can be a memory-mapped file: it is neither copied nor split in lines.
+             *  - `#` comments can start anywhere, even at the end of a data line,
+             *  - the header can be `OFF`, `COFF`, `NOFF`, `CNOFF` or `STOFF` variants, and the sizes can follow it on the same line,
+             *  - vertex colors, normals and texture coordinates, as well as facet colors, are skipped.
+             * @param first first character of the buffer
+             * @param last past the last character of the buffer
+             * @return the mesh, filled without any allocation per point or per facet
+             */
+            static shadow::FlatMesh parse_flat(char const* first, char const* last)
+            {
+                Scanner scanner(first, last);
+
+                scanner.skip_comments();
+                if(scanner.at_end())
                     throw std::out_of_range("The stream contains only comments and/or empty lines!");
 
-                if (lines.at(0) != "OFF")
-                    throw std::ios_base::failure("Not identified as OFF format! OFF files starts with a \'OFF\' hearder line.");                
+                read_keyword(scanner.read_word());
 
-                if (lines.size() <= 1)
+                scanner.skip_comments();
+                if(scanner.at_end())
                     throw std::out_of_range("The stream contains only the header; nothing to parse!");
 
-                auto sizes = read_header(lines);
-
-                mesh = shadow::Mesh(
-                    read_points(
-                        lines,
-                        sizes[0]
-                    ),
-                    read_faces(
-                        lines,
-                        2 + sizes[0],
-                        sizes[1]
-                    )
+                long number_of_points(0), number_of_faces(0);
+                if(!scanner.read_integer(number_of_points) || (scanner.skip_comments(), !scanner.read_integer(number_of_faces)) || number_of_points < 0 || number_of_faces < 0)
+                    throw std::range_error("Error parsing the sizes! There should be 2 positive integers followed by the number of edges.");
+                /* The number of edges is not used */
+                scanner.skip_line();
+
+                shadow::FlatMesh mesh;
+                /* The sizes are not trusted further than the buffer can hold: every point or facet takes at least two characters */
+                std::size_t const capacity(static_cast<std::size_t>(last - first) / 2);
+                /* Facets are mostly triangles */
+                mesh.reserve(
+                    std::min(static_cast<std::size_t>(number_of_points), capacity),
+                    std::min(static_cast<std::size_t>(number_of_faces), capacity),
+                    std::min(3 * static_cast<std::size_t>(number_of_faces), capacity)
                 );
+                for(long point(0); point != number_of_points; ++point)
+                {
+                    /* The coordinates of a point are on the same line */
+                    scanner.skip_comments();
+                    double coordinates[3];
+                    for(auto & coordinate : coordinates)
+                        if(!scanner.read_double(coordinate))
+                            throw std::range_error("Error parsing point! Each point should have 3 coordinates.");
+                    mesh.add_point(coordinates[0], coordinates[1], coordinates[2]);
+                    scanner.skip_line();
+                }
+
+                std::vector<std::size_t> indexes;
+                for(long face(0); face != number_of_faces; ++face)
+                {
+                    long size(0);
+                    scanner.skip_comments();
+                    if(!scanner.read_integer(size) || size < 0)
+                        throw std::range_error("Error parsing facet! Each facet starts with its number of points.");
+
+                    indexes.resize(static_cast<std::size_t>(size));
+                    for(auto & index : indexes)
+                    {
+                        long buffer(0);
+                        if(!scanner.read_integer(buffer) || buffer < 0 || buffer >= number_of_points)
+                            throw std::range_error("Error parsing facet! The number of points parsed do not match the number of points in the line.");
+                        index = static_cast<std::size_t>(buffer);
+                    }
+                    mesh.add_face(std::begin(indexes), std::end(indexes));
+                    scanner.skip_line();
+                }
 
-                return *this;
+                return mesh;
             }
 
         private:
             /** reference to a stream */
             std::iostream & ios;
+            /** coordinate format */
+            Point_format format;
 
-            void print_header(shadow::Mesh const& mesh)
+            void print_header(Buffered_stream & out, shadow::Mesh const& mesh)
             {
-                ios << "# Mesh: " << mesh.get_name() << std::endl
-                    << "OFF" << std::endl
-                    << mesh.points_size() << " " << mesh.faces_size() << " 0" << std::endl;
+                out << "# Mesh: " << mesh.get_name() << '\n'
+                    << "OFF\n"
+                    << mesh.points_size() << ' ' << mesh.faces_size() << " 0\n";
             }
-            void print_points(shadow::Mesh const& mesh)
+            void print_points(Buffered_stream & out, shadow::Mesh const& mesh)
             {
                 std::for_each(
                     mesh.points_cbegin(),
                     mesh.points_cend(),
-                    [this](shadow::Point const& points)
+                    [this, &out](shadow::Point const& point)
                     {
-                        ios << points << std::endl;
+                        format.write(out, point) << '\n';
                     }
                 );
             }
-            void print_faces(shadow::Mesh const& mesh)
+            void print_faces(Buffered_stream & out, shadow::Mesh const& mesh)
             {
                 std::for_each(
                     mesh.faces_cbegin(),
                     mesh.faces_cend(),
-                    [this](shadow::Face const& facets)
+                    [&out](shadow::Face const& facet)
                     {
-                        ios << facets << std::endl;
+                        out << facet.degree();
+                        for(auto const index : facet)
+                            out << ' ' << index;
+                        out << '\n';
                     }
                 );
             }
 
-            std::vector<std::string> parse(void)
-            {
-                std::vector<std::string> lines;
-                readlines(ios, std::back_inserter(lines));
-
-                /*Ignore Comments*/
-                lines.erase(
-                    std::remove_if(
-                        std::begin(lines),
-                        std::end(lines),
-                        [](std::string const& line)
-                        {
-                            return line.at(0) == '#' || line.empty();
-                        }
-                    ),
-                    std::end(lines)
-                );
-
-                return lines;
-            }
-            std::vector<std::size_t> read_header(std::vector<std::string> const& lines)
-            {
-                std::vector<std::size_t> sizes(3);
-                std::stringstream _sizes(lines[1]);
-                std::copy(
-                    std::istream_iterator<std::size_t>(_sizes),
-                    std::istream_iterator<std::size_t>(),
-                    std::begin(sizes)
-                );
-                if(sizes.size() != 3)
-                    throw std::range_error("Error parsing the second line! There should be 3 integers.");
-                if(sizes[2] != 0)
-                    throw std::range_error("Error parsing the second line! The first and second integers should be positive and the third is always equal to 0.");
-                if(lines.size() != (2 + sizes[0] + sizes[1]))
-                    throw std::range_error("Error parsing the second line! The file should exactly contain the header, the sizes, the points and the faces: no more and no less.");
-
-                return sizes;
-            }
-            std::vector<shadow::Point> read_points(std::vector<std::string> const& lines, std::size_t const number_of_points)
-            {
-                std::vector<std::string> buffer_lines(static_cast<std::size_t>(number_of_points));
-                std::copy(
-                    std::next(std::begin(lines), 2),
-                    std::next(std::begin(lines), 2 + static_cast<long>(number_of_points)),
-                    std::begin(buffer_lines)
-                );
-
-                std::vector<shadow::Point> points(buffer_lines.size());
-                std::transform(
-                    std::begin(buffer_lines),
-                    std::end(buffer_lines),
-                    std::begin(points),
-                    [](std::string const& line)
-                    {
-                        std::vector<double> coordinates;
-                        coordinates.reserve(3);
-                        std::istringstream sline(line);
-                        std::copy(
-                            std::istream_iterator<double>(sline),
-                            std::istream_iterator<double>(),
-                            std::back_inserter(coordinates)
-                        );
-                        return shadow::Point(coordinates[0], coordinates[1], coordinates[2]);
-                    }
-                );
-
-                return points;
-            }
-            std::vector<shadow::Face> read_faces(std::vector<std::string> const& lines, std::size_t const shift, std::size_t const number_of_faces)
+            /**
+             * Checks an OFF header keyword: [ST][C][N]OFF.
+             * @param keyword the first word of the stream
+             */
+            static void read_keyword(std::string const& keyword)
             {
-                std::vector<std::string> buffer_lines(number_of_faces);
-                std::copy(
-                    std::next(std::begin(lines), static_cast<long>(shift)),
-                    std::next(std::begin(lines), static_cast<long>(shift) + static_cast<long>(number_of_faces)),
-                    std::begin(buffer_lines)
-                );
-
-                std::vector<shadow::Face> faces(buffer_lines.size());
-
-                std::transform(
-                    std::begin(buffer_lines),
-                    std::end(buffer_lines),
-                    std::begin(faces),
-                    [](std::string const& line)
-                    {
-                        std::vector<std::size_t> indexes;
-                        std::istringstream sline(line);
-                        std::size_t n(0);
-                        sline >> n;
-                        indexes.resize(n);
-
-                        std::copy(
-                            std::istream_iterator<std::size_t>(sline),
-                            std::istream_iterator<std::size_t>(),
-                            std::begin(indexes)
-                        );
-
-                        if (indexes.size() != n)
-                            throw std::range_error("Error parsing facet! The number of points parsed do not match the number of points in the line.");
-                        return shadow::Face(indexes);
-                    }
-                );
-
-                return faces;
+                std::string prefix(keyword.size() >= 3 && keyword.compare(keyword.size() - 3, 3, "OFF") == 0 ? keyword.substr(0, keyword.size() - 3) : "?");
+                if(prefix.compare(0, 2, "ST") == 0)
+                    prefix.erase(0, 2);
+                if(!prefix.empty() && prefix.front() == 'C')
+                    prefix.erase(0, 1);
+                if(!prefix.empty() && prefix.front() == 'N')
+                    prefix.erase(0, 1);
+                if(!prefix.empty())
+                    throw std::ios_base::failure("Not identified as OFF format! OFF files starts with a \'OFF\' hearder line.");
             }
         };
     }
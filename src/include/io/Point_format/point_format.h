@@ -0,0 +1,111 @@
+#pragma once
+
+#include <shadow/point.h>
+#include <shadow/vector.h>
+
+#include <io/Buffered_stream/buffered_stream.h>
+
+#include <stdexcept>
+
+namespace city
+{
+    namespace io
+    {
+        /**
+         * @ingroup io
+         * @brief Formats shadow Point and Vector coordinates as text, without the iostream machinery.
+         *
+         * Coordinates are separated by spaces and written either with the fewest digits reading back to the same value,
+         * or rounded to a fixed number of decimals: 3 decimals keep millimetres on georeferenced coordinates.
+         * Trailing zeros are never written.
+         */
+        class Point_format
+        {
+        public:
+            /** Decimals value selecting the shortest round-trip representation */
+            static const int round_trip = -1;
+            /** Size of the text buffer needed by print() */
+            static const std::size_t max_length = 3 * 32;
+
+            /**
+             * Constructor
+             * @param _decimals number of decimals, from 0 to 9, or round_trip
+             */
+            explicit Point_format(int const _decimals = round_trip)
+                : decimals(_decimals)
+            {
+                if(decimals < round_trip || decimals > 9)
+                    throw std::out_of_range("The number of decimals must be round_trip or lie between 0 and 9!");
+            }
+
+            int get_decimals(void) const noexcept
+            {
+                return decimals;
+            }
+
+            /**
+             * Formats a Point as `x y z`.
+             * @param point point to format
+             * @param text buffer of at least max_length characters
+             * @return the number of characters written
+             */
+            std::size_t print(shadow::Point const& point, char* text) const
+            {
+                return print(point.x(), point.y(), point.z(), text);
+            }
+            /**
+             * Formats a Vector as `x y z`.
+             * @param vector vector to format
+             * @param text buffer of at least max_length characters
+             * @return the number of characters written
+             */
+            std::size_t print(shadow::Vector const& vector, char* text) const
+            {
+                return print(vector.x(), vector.y(), vector.z(), text);
+            }
+
+            /**
+             * Writes a Point as `x y z` to a buffered stream.
+             * @param out output stream
+             * @param point point to write
+             * @return reference to the output stream
+             */
+            Buffered_stream & write(Buffered_stream & out, shadow::Point const& point) const
+            {
+                char text[max_length];
+                return out.write(text, print(point, text));
+            }
+            /**
+             * Writes a Vector as `x y z` to a buffered stream.
+             * @param out output stream
+             * @param vector vector to write
+             * @return reference to the output stream
+             */
+            Buffered_stream & write(Buffered_stream & out, shadow::Vector const& vector) const
+            {
+                char text[max_length];
+                return out.write(text, print(vector, text));
+            }
+        private:
+            /** number of decimals, or round_trip */
+            int decimals;
+
+            std::size_t print(double const x, double const y, double const z, char* text) const
+            {
+                char* cursor = text;
+                cursor += print(x, cursor);
+                *cursor++ = ' ';
+                cursor += print(y, cursor);
+                *cursor++ = ' ';
+                cursor += print(z, cursor);
+                return static_cast<std::size_t>(cursor - text);
+            }
+            std::size_t print(double const coordinate, char* text) const
+            {
+                if(decimals == round_trip)
+                    return Buffered_stream::shortest(coordinate, text);
+                return Buffered_stream::fixed(coordinate, static_cast<std::size_t>(decimals), text);
+            }
+        };
+    }
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <string>
+#include <array>
+#include <algorithm>
+#include <limits>
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+
+namespace city
+{
+    namespace io
+    {
+        /**
+         * @ingroup io
+         * @brief Single pass scanner over a character buffer, used to parse text formats without copying lines.
+         *
+         * The buffer does not need to be null terminated, so that it can be a memory-mapped file.
+         * Numbers are parsed in place: decimal numbers with few significant digits take an exact fast path,
+         * the others fall back to `std::strtod` on a small local copy.
+         */
+        class Scanner
+        {
+        public:
+            /**
+             * Constructor from a character range
+             * @param _first first character
+             * @param _last past the last character
+             */
+            Scanner(char const* _first, char const* _last)
+                : cursor(_first), last(_last)
+            {}
+
+            /**
+             * Checks if the whole buffer is consumed.
+             * @return true at the end of the buffer
+             */
+            bool at_end(void) const noexcept
+            {
+                return cursor == last;
+            }
+            /**
+             * Checks if the cursor reached the end of the current line.
+             * @return true at the end of a line or of the buffer
+             */
+            bool at_line_end(void) const noexcept
+            {
+                return cursor == last || *cursor == '\n';
+            }
+            /**
+             * Current character, or '\0' at the end of the buffer.
+             * @return the current character
+             */
+            char peek(void) const noexcept
+            {
+                return cursor == last ? '\0' : *cursor;
+            }
+            /**
+             * Skips one character.
+             */
+            void advance(void) noexcept
+            {
+                if(cursor != last)
+                    ++cursor;
+            }
+
+            /**
+             * Skips spaces, tabs and carriage returns on the current line.
+             */
+            void skip_blanks(void) noexcept
+            {
+                while(cursor != last && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r'))
+                    ++cursor;
+            }
+            /**
+             * Skips blanks and line breaks.
+             */
+            void skip_whitespaces(void) noexcept
+            {
+                while(cursor != last && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n'))
+                    ++cursor;
+            }
+            /**
+             * Skips blanks, line breaks and `#` comments up to the next token.
+             */
+            void skip_comments(void) noexcept
+            {
+                for(skip_whitespaces(); cursor != last && *cursor == '#'; skip_whitespaces())
+                    skip_line();
+            }
+            /**
+             * Moves the cursor to the beginning of the next line.
+             */
+            void skip_line(void) noexcept
+            {
+                cursor = std::find(cursor, last, '\n');
+                if(cursor != last)
+                    ++cursor;
+            }
+
+            /**
+             * Reads a word delimited by whitespaces on the current line.
+             * @return the word, empty if the line is over
+             */
+            std::string read_word(void)
+            {
+                skip_blanks();
+                char const* begin = cursor;
+                while(cursor != last && !is_space(*cursor))
+                    ++cursor;
+                return std::string(begin, cursor);
+            }
+
+            /**
+             * Reads an integer on the current line.
+             * @param value the parsed value
+             * @return false if there is no integer at the cursor, or if it does not fit in a long
+             */
+            bool read_integer(long & value) noexcept
+            {
+                skip_blanks();
+                char const* begin = cursor;
+                bool negative = cursor != last && *cursor == '-';
+                if(cursor != last && (*cursor == '-' || *cursor == '+'))
+                    ++cursor;
+
+                char const* digits = cursor;
+                long result(0);
+                for(; cursor != last && is_digit(*cursor); ++cursor)
+                {
+                    long const digit(*cursor - '0');
+                    if(result > (std::numeric_limits<long>::max() - digit) / 10)
+                    {
+                        cursor = begin;
+                        return false;
+                    }
+                    result = result * 10 + digit;
+                }
+
+                if(cursor == digits)
+                {
+                    cursor = begin;
+                    return false;
+                }
+                value = negative ? -result : result;
+                return true;
+            }
+
+            /**
+             * Reads a floating point number on the current line.
+             * @param value the parsed value
+             * @return false if there is no number at the cursor
+             */
+            bool read_double(double & value)
+            {
+                skip_blanks();
+                char const* begin = cursor;
+
+                bool negative = cursor != last && *cursor == '-';
+                if(cursor != last && (*cursor == '-' || *cursor == '+'))
+                    ++cursor;
+
+                std::uint64_t mantissa(0);
+                int significant(0), exponent(0);
+                bool any_digit(false);
+                for(; cursor != last && is_digit(*cursor); ++cursor, any_digit = true)
+                    accumulate(mantissa, significant, exponent, *cursor, false);
+                if(cursor != last && *cursor == '.')
+                    for(++cursor; cursor != last && is_digit(*cursor); ++cursor, any_digit = true)
+                        accumulate(mantissa, significant, exponent, *cursor, true);
+
+                if(!any_digit)
+                    return fallback(begin, value);
+
+                if(cursor != last && (*cursor == 'e' || *cursor == 'E'))
+                {
+                    char const* exponent_begin = cursor++;
+                    bool exponent_negative = cursor != last && *cursor == '-';
+                    if(cursor != last && (*cursor == '-' || *cursor == '+'))
+                        ++cursor;
+                    if(cursor == last || !is_digit(*cursor))
+                        cursor = exponent_begin;
+                    else
+                    {
+                        int explicit_exponent(0);
+                        for(; cursor != last && is_digit(*cursor); ++cursor)
+                            explicit_exponent = std::min(explicit_exponent * 10 + (*cursor - '0'), 100000);
+                        exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+                    }
+                }
+                if(cursor != last && !is_delimiter(*cursor))
+                    return fallback(begin, value);
+
+                /* Exact when the mantissa and the power of ten are both exactly representable */
+                static const std::array<double, 23> powers{{
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                }};
+                if(significant > 15 || exponent < -22 || exponent > 22)
+                    return fallback(begin, value);
+
+                double result = static_cast<double>(mantissa);
+                result = exponent < 0 ? result / powers[static_cast<std::size_t>(-exponent)] : result * powers[static_cast<std::size_t>(exponent)];
+                value = negative ? -result : result;
+                return true;
+            }
+
+        private:
+            /** current position */
+            char const* cursor;
+            /** past the end of the buffer */
+            char const* last;
+
+            static bool is_digit(char const c) noexcept
+            {
+                return c >= '0' && c <= '9';
+            }
+            static bool is_space(char const c) noexcept
+            {
+                return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+            }
+            static bool is_delimiter(char const c) noexcept
+            {
+                return is_space(c) || c == '/' || c == '#';
+            }
+
+            /**
+             * Adds a digit to the mantissa, counting significant digits and the decimal exponent.
+             * Digits beyond the 19th cannot be held: the parsing then falls back to strtod anyway.
+             */
+            static void accumulate(std::uint64_t & mantissa, int & significant, int & exponent, char const digit, bool const fractional) noexcept
+            {
+                if(mantissa == 0 && digit == '0')
+                {
+                    exponent -= fractional;
+                    return;
+                }
+                if(significant < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(digit - '0');
+                    exponent -= fractional;
+                }
+                else
+                    exponent += !fractional;
+                ++significant;
+            }
+
+            /**
+             * Parses the token at `begin` with strtod on a null terminated copy.
+             * @param begin beginning of the token
+             * @param value the parsed value
+             * @return false if strtod cannot parse the token
+             */
+            bool fallback(char const* begin, double & value)
+            {
+                char const* end = begin;
+                while(end != last && !is_space(*end) && *end != '/' && *end != '#')
+                    ++end;
+
+                std::string token(begin, end);
+                char* parsed_end = nullptr;
+                value = std::strtod(token.c_str(), &parsed_end);
+                if(parsed_end == token.c_str())
+                {
+                    cursor = begin;
+                    return false;
+                }
+                cursor = begin + (parsed_end - token.c_str());
+                return true;
+            }
+        };
+    }
+}
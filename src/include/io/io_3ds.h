@@ -23,8 +23,8 @@ namespace city
             T3DSHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes);
             ~T3DSHandler(void);
 
-            ::city::scene::Scene get_scene(SceneTreeHandler const& scene_tree_file, bool from_xml = true);
-            scene::Scene get_scene(void);
+            ::city::scene::Scene get_scene(SceneTreeHandler const& scene_tree_file, bool from_xml = true, std::size_t const workers = 1, double const weld_tolerance = scene::Scene::no_welding);
+            scene::Scene get_scene(std::size_t const workers = 1, double const weld_tolerance = scene::Scene::no_welding);
 
             std::vector<shadow::Mesh> get_meshes(void);
 
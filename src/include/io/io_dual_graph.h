@@ -0,0 +1,107 @@
+#pragma once
+
+#include <io/io.h>
+
+#include <scene/facet_graph.h>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdint>
+
+#include <map>
+#include <vector>
+#include <string>
+
+namespace city
+{
+    namespace io
+    {
+        /**
+         * @ingroup io
+         * @brief Header of binary dual graph files.
+         *
+         * A file is the header followed by `facets x attributes` float32 values in row major order,
+         * then `edges` pairs of uint32 facet positions, each undirected edge being written once with the smaller position first.
+         * Every field is in the byte order of the machine that wrote it, little endian in practice:
+         * a reader with the other byte order rejects the file on its version.
+         */
+        struct DualGraphHeader
+        {
+            /** File signature: "CDG" followed by a zero byte */
+            char magic[4];
+            /** Format version */
+            std::uint32_t version;
+            /** Number of facets, i.e. of graph vertices */
+            std::uint32_t facets;
+            /** Number of attribute columns per facet */
+            std::uint32_t attributes;
+            /** Number of undirected edges */
+            std::uint32_t edges;
+            /** Padding, keeps the attributes 8 bytes aligned */
+            std::uint32_t reserved;
+        };
+
+        /**
+         * @ingroup io
+         * @brief Read only view on a memory-mapped binary dual graph file.
+         *
+         * Attributes and edges are not copied: the pointers refer to the mapping, which lives as long as the view and its copies.
+         */
+        class DualGraph
+        {
+        public:
+            DualGraph(void);
+            /**
+             * Maps a binary dual graph file and checks its layout.
+             * @param filepath path to the file
+             */
+            explicit DualGraph(boost::filesystem::path const& filepath);
+
+            std::size_t facets_size(void) const noexcept;
+            std::size_t attributes_size(void) const noexcept;
+            std::size_t edges_size(void) const noexcept;
+
+            /**
+             * Access the attribute matrix
+             * @return the first of `facets_size() * attributes_size()` row major values
+             */
+            float const* attributes(void) const noexcept;
+            /**
+             * Access a facet attribute
+             * @param facet facet position
+             * @param column attribute column
+             * @return the attribute value
+             */
+            float attribute(std::size_t const facet, std::size_t const column) const;
+            /**
+             * Access the edge list
+             * @return the first of `2 * edges_size()` facet positions
+             */
+            std::uint32_t const* edges(void) const noexcept;
+        private:
+            boost::iostreams::mapped_file_source file;
+            DualGraphHeader header;
+            float const* attribute_data = nullptr;
+            std::uint32_t const* edge_data = nullptr;
+        };
+
+        class DualGraphHandler: protected FileHandler
+        {
+        public:
+            DualGraphHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes);
+            ~DualGraphHandler(void);
+
+            DualGraph read(void);
+
+            /**
+             * Writes a dual graph.
+             * @param attributes row major facet attributes, converted to float32
+             * @param columns number of attributes per facet
+             * @param graph facet adjacency
+             */
+            void write(std::vector<double> const& attributes, std::size_t const columns, scene::FacetGraph const& graph);
+
+            static const std::uint32_t version;
+        };
+    }
+}
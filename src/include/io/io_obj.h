@@ -1,8 +1,10 @@
 #pragma once
 
 #include <io/io.h>
+#include <io/Point_format/point_format.h>
 
 #include <shadow/mesh.h>
+#include <shadow/flat_mesh.h>
 #include <scene/scene.h>
 
 
@@ -21,13 +23,28 @@ namespace city
             std::vector<shadow::Mesh> const& data(void) const noexcept;
             
             WaveObjHandler& read(void);
+            /**
+             * Reads the obj file without converting it to meshes, nor keeping it in the handler.
+             * @return the flat meshes, sorted by name
+             */
+            std::vector<shadow::FlatMesh> read_flat(void);
 
             shadow::Mesh exclude_mesh(std::string const& excluded);
             void add_mesh(shadow::Mesh const& mesh);
 
-            void write(void);
-
-            scene::Scene get_scene(void);
+            /**
+             * Writes the obj file.
+             * @param decimals number of decimals of the written coordinates, or Point_format::round_trip for exact values
+             */
+            void write(int const decimals = Point_format::round_trip);
+
+            /**
+             * Builds the scene from the parsed meshes, which are moved into it.
+             * @param workers number of threads converting meshes to nodes, 0 meaning all hardware threads
+             * @param weld_tolerance tolerance of the point welding applied to each mesh, or scene::Scene::no_welding
+             * @return the scene
+             */
+            scene::Scene get_scene(std::size_t const workers = 1, double const weld_tolerance = scene::Scene::no_welding);
         private:
             std::vector<shadow::Mesh> meshes;
         };
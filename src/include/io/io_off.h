@@ -1,8 +1,10 @@
 #pragma once
 
 #include <io/io.h>
+#include <io/Point_format/point_format.h>
 
 #include <shadow/mesh.h>
+#include <shadow/flat_mesh.h>
 
 namespace city
 {
@@ -15,7 +17,17 @@ namespace city
             ~OFFHandler(void);
             
             shadow::Mesh read(void);
-            void write(shadow::Mesh const& mesh);
+            /**
+             * Reads the OFF file without converting it to a Mesh.
+             * @return the flat mesh
+             */
+            shadow::FlatMesh read_flat(void);
+            /**
+             * Writes the OFF file.
+             * @param mesh mesh to write
+             * @param decimals number of decimals of the written coordinates, or Point_format::round_trip for exact values
+             */
+            void write(shadow::Mesh const& mesh, int const decimals = Point_format::round_trip);
         };
     }
 }
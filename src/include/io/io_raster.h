@@ -23,6 +23,15 @@ namespace city
             projection::RasterPrint read(void);
 
             void write(projection::RasterPrint const& raster_image);
+            /**
+             * Rasterizes a footprint straight into a tiled and compressed GeoTIFF.
+             * The raster is never held in memory as a whole: it is filled and written block by block.
+             * @param footprint the footprint to rasterize
+             * @param pixel_size pixel size
+             * @param workers number of threads, 0 meaning all hardware threads
+             * @param format sample type, scale and offset of the file
+             */
+            void write(projection::FootPrint const& footprint, double const pixel_size, std::size_t const workers = 1, projection::SampleFormat const& format = projection::SampleFormat());
         };
     }
 }
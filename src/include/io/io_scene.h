@@ -15,14 +15,15 @@ namespace city
             t3ds_xml,
             t3ds,
             off,
-            obj
+            obj,
+            cache
         };
 
         class SceneHandler: protected FileHandler
         {
         public:
-            SceneHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes, std::string const& _format="OFF");
-            SceneHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes, SceneFormat const _format=SceneFormat::off);
+            SceneHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes, std::string const& _format="OFF", std::size_t const _workers=1, double const _weld_tolerance=scene::Scene::no_welding);
+            SceneHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes, SceneFormat const _format=SceneFormat::off, std::size_t const _workers=1, double const _weld_tolerance=scene::Scene::no_welding);
             ~SceneHandler(void);
 
             scene::Scene read(void) const;
@@ -36,8 +37,18 @@ namespace city
             static const std::vector<std::string> supported_extentions;
         private:
             SceneFormat format;
+            /** Number of threads used to read the scene, 0 meaning all hardware threads */
+            std::size_t workers;
+            /** Tolerance of the point welding applied to the meshes on read, negative to keep them as they are */
+            double weld_tolerance;
 
             void check_extension(void) const;
+            /**
+             * Reads an OFF mesh as a node, welded when a tolerance is set.
+             * @param mesh_path path to the OFF file
+             * @return the node
+             */
+            scene::UNode read_node(boost::filesystem::path const& mesh_path) const;
         };
     }
 }
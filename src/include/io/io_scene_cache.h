@@ -0,0 +1,171 @@
+#pragma once
+
+#include <io/io.h>
+
+#include <scene/scene.h>
+#include <scene/unode.h>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdint>
+
+#include <map>
+#include <vector>
+#include <string>
+
+namespace city
+{
+    namespace io
+    {
+        /**
+         * @ingroup io
+         * @brief Stamp of the source scene and reading options of a binary scene cache.
+         *
+         * A cache is stale as soon as the stamp of the scene on disk, or of the reading options, differs from the recorded one.
+         */
+        struct SceneCacheSource
+        {
+            /** Latest last write time of the source files, in seconds since the epoch */
+            std::int64_t last_write_time;
+            /** Total size of the source files, in bytes */
+            std::uint64_t size;
+            /** Welding tolerance the meshes were read with, negative when they were not welded */
+            double weld_tolerance;
+            /** Source scene format, as a SceneFormat */
+            std::uint32_t format;
+            /** Padding, keeps the stamp 8 bytes aligned */
+            std::uint32_t reserved;
+
+            /**
+             * Stamps a source scene.
+             * Only the files the scene reader opens are stamped: the files of a directory with the extension of the format,
+             * or the scene file, along with the `<stem>.XML` tree of a 3DS scene.
+             * @param scene_path path to the source scene
+             * @param format source scene format
+             * @param weld_tolerance welding tolerance used to read the scene
+             * @return the stamp
+             */
+            static SceneCacheSource stamp(boost::filesystem::path const& scene_path, std::uint32_t const format, double const weld_tolerance);
+        };
+
+        bool operator ==(SceneCacheSource const& lhs, SceneCacheSource const& rhs) noexcept;
+        bool operator !=(SceneCacheSource const& lhs, SceneCacheSource const& rhs) noexcept;
+
+        /**
+         * @ingroup io
+         * @brief Header of binary scene cache files.
+         *
+         * A file is the header, holding the SceneCacheSource stamp of the scene it was built from,
+         * followed by one record per building, then one for the terrain.
+         * Every record is a SceneCacheRecord followed by:
+         *  - the node name, padded with zeros to a multiple of 8 bytes,
+         *  - the x, y then z float64 coordinates of the points,
+         *  - `faces + 1` uint32 face offsets and the uint32 face indices, as in shadow::FlatMesh,
+         *  - `facet_ids` uint32 facet ids, then zeros up to a multiple of 8 bytes.
+         * Every field is in the byte order of the machine that wrote it, little endian in practice:
+         * a reader with the other byte order rejects the file on its version.
+         */
+        struct SceneCacheHeader
+        {
+            /** File signature: "CSC" followed by a zero byte */
+            char magic[4];
+            /** Format version */
+            std::uint32_t version;
+            /** EPSG projection system code */
+            std::uint32_t epsg;
+            /** Number of building records */
+            std::uint32_t buildings;
+            /** Pruning flags: 1 if the buildings were pruned, 2 if the terrain was */
+            std::uint32_t pruned;
+            /** Padding, keeps the pivot 8 bytes aligned */
+            std::uint32_t reserved;
+            /** Pivot coordinates */
+            double pivot[3];
+            /** Source scene stamp, zero when unknown */
+            SceneCacheSource source;
+        };
+
+        /**
+         * @ingroup io
+         * @brief Sizes of a node record in a binary scene cache file.
+         */
+        struct SceneCacheRecord
+        {
+            /** Number of characters of the node name */
+            std::uint32_t name_size;
+            /** Number of points */
+            std::uint32_t points;
+            /** Number of facets */
+            std::uint32_t faces;
+            /** Total number of facet indices */
+            std::uint32_t indices;
+            /** Number of facet ids: 0, or one per facet */
+            std::uint32_t facet_ids;
+            /** Padding, keeps the coordinates 8 bytes aligned */
+            std::uint32_t reserved;
+        };
+
+        /**
+         * @ingroup io
+         * @brief Read only view on a memory-mapped binary scene cache file.
+         *
+         * Nodes are rebuilt straight from the mapping, without the parsing and soup orientation of the source formats.
+         */
+        class SceneCache
+        {
+        public:
+            SceneCache(void);
+            /**
+             * Maps a binary scene cache file and checks its layout.
+             * @param filepath path to the file
+             */
+            explicit SceneCache(boost::filesystem::path const& filepath);
+
+            shadow::Point pivot(void) const noexcept;
+            unsigned short epsg(void) const noexcept;
+            std::size_t buildings_size(void) const noexcept;
+            bool pruned_buildings(void) const noexcept;
+            bool pruned_terrain(void) const noexcept;
+            SceneCacheSource const& source(void) const noexcept;
+
+            /**
+             * Rebuilds a node.
+             * @param index building position, or buildings_size() for the terrain
+             * @return the node
+             */
+            scene::UNode node(std::size_t const index) const;
+            /**
+             * Rebuilds the scene, one node per work item.
+             * @param workers number of threads, 0 meaning all hardware threads
+             * @return the scene
+             */
+            scene::Scene to_scene(std::size_t const workers = 1) const;
+        private:
+            boost::iostreams::mapped_file_source file;
+            SceneCacheHeader header;
+            /** Position of each record in the file, the terrain one last */
+            std::vector<std::size_t> records;
+        };
+
+        class SceneCacheHandler: protected FileHandler
+        {
+        public:
+            SceneCacheHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes);
+            ~SceneCacheHandler(void);
+
+            SceneCache read(void);
+
+            /**
+             * Writes a scene.
+             * The facet ids of pruned nodes are written too, as projections refer to them.
+             * @param scene the scene to cache
+             * @param pruned whether the buildings were pruned
+             * @param terrain whether the terrain was pruned
+             * @param source stamp of the source scene
+             */
+            void write(scene::Scene const& scene, bool const pruned = false, bool const terrain = false, SceneCacheSource const& source = SceneCacheSource());
+
+            static const std::uint32_t version;
+        };
+    }
+}
@@ -6,6 +6,10 @@
 
 #include <ogrsf_frmts.h>
 
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
 #include <string>
 #include <vector>
 
@@ -58,18 +62,74 @@ namespace city
             double area(void) const;
             std::vector<double> edge_lengths(void) const;
             double circumference(void) const;
+
+            /**
+            * Access the union of all projected facets.
+            * It is built on first use, then joined with every facet added by `operator +=`,
+            * and only rebuilt after `occlusion()` cuts the facets away.
+            * @return the facets union
+            */
+            Polygon_set const& facets_union(void) const;
             
             void filter(void);
 
             BrickPrint & operator +=(FacePrint const& lfacet);
+            BrickPrint & operator +=(FacePrint && lfacet);
             BrickPrint & operator +=(BrickPrint const& other);
+            /**
+            * Adds the facets of a brick print that is no longer needed.
+            * Facets are moved instead of copied, and an empty print takes over
+            * the other facets, index and union as they are.
+            * @param other the brick print to add, left empty
+            * @return reference to the brick print
+            */
+            BrickPrint & operator +=(BrickPrint && other);
 
             std::vector<FacePrint> occlusion(FacePrint const& lfacet);
 
             void to_ogr(OGRLayer* projection_layer, shadow::Point const& reference_point, bool labels) const;
         private:
+            using Index_point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+            using Index_box = boost::geometry::model::box<Index_point>;
+            using Index_value = std::pair<Index_box, std::size_t>;
+            using Facet_index = boost::geometry::index::rtree<Index_value, boost::geometry::index::quadratic<16> >;
+
             Bbox_2 bounding_box;
             std::vector<FacePrint> projected_facets;
+            /** R-tree over the projected facets bounding boxes, valued by facet position */
+            Facet_index facet_index;
+            /** Cached union of the projected facets */
+            mutable Polygon_set union_cache;
+            /** Whether `union_cache` matches `projected_facets` */
+            mutable bool union_cached = false;
+
+            static Index_box index_box(Bbox_2 const& box);
+            /**
+            * Rebuilds the facet index from scratch.
+            * Must be called whenever `projected_facets` is reordered or replaced.
+            */
+            void index_facets(void);
+            /**
+            * Appends a facet and registers it in the facet index.
+            * @param facet the facet to append
+            */
+            void push_facet(FacePrint const& facet);
+            void push_facet(FacePrint && facet);
+            /**
+            * Finds the facets whose bounding boxes overlap a given box.
+            * Facets outside this set cannot intersect anything inside the box.
+            * @param box the query bounding box
+            * @return sorted positions of candidate facets
+            */
+            std::vector<std::size_t> candidates(Bbox_2 const& box) const;
+            /**
+            * Joins the candidate facets polygons.
+            * The facets union is returned instead when it is already built, or when every facet is a candidate:
+            * both agree inside the box.
+            * @param box the query bounding box
+            * @return a polygon set matching the union of all facets overlapping the box, inside the box
+            */
+            Polygon_set candidate_union(Bbox_2 const& box) const;
 
             bool equal_facets(BrickPrint const& other) const;
 
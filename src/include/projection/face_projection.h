@@ -7,6 +7,7 @@
 #include <ogrsf_frmts.h>
 
 #include <vector>
+#include <array>
 #include <utility>
 
 #include <ostream>
@@ -16,6 +17,32 @@ namespace city
     namespace projection
     {
         class RasterPrint;
+
+        /**
+         * Rasterization algorithms:
+         *  - exact: each pixel is intersected with the facet in the exact kernel,
+         *      a pixel is hit when the intersection has a positive area and takes the plane height at the intersection centroid.
+         *      It is slow and kept as a reference.
+         *  - scanline: coverage and heights are computed in doubles, row by row,
+         *      a pixel is hit when its center lies inside the facet and takes the plane height at its center.
+         *      Boundary pixels thus differ from the exact mode, which stays the default: the scanline mode has to be asked for.
+         */
+        enum class Rasterization
+        {
+            exact,
+            scanline
+        };
+
+        /**
+         * Pixel window of a raster: rows in [row_begin, row_end) and columns in [column_begin, column_end).
+         */
+        struct PixelWindow
+        {
+            std::size_t row_begin;
+            std::size_t row_end;
+            std::size_t column_begin;
+            std::size_t column_end;
+        };
         
         class FacePrint
         {
@@ -76,17 +103,71 @@ namespace city
 
             OGRFeature* to_ogr(OGRFeatureDefn* feature_definition, shadow::Point const& reference_point, bool labels) const;
             
-            std::vector<double> & rasterize(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const height, std::size_t const width, double const pixel_size) const;
+            std::vector<double> & rasterize(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const height, std::size_t const width, double const pixel_size, Rasterization const mode = Rasterization::exact) const;
+            /**
+             * Rasterizes the facet only on the pixels of a window.
+             * Pixels outside the window are left untouched, so disjoint windows of the same raster can be filled concurrently.
+             * @param image running mean heights of the raster
+             * @param hits number of facets averaged in each pixel
+             * @param top_left top left corner of the raster
+             * @param height raster height
+             * @param width raster width
+             * @param pixel_size pixel size
+             * @param mode rasterization algorithm
+             * @param window pixels to fill
+             * @return the image
+             */
+            std::vector<double> & rasterize(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const height, std::size_t const width, double const pixel_size, Rasterization const mode, PixelWindow const& window) const;
         private:
             std::size_t id;
             Polygon_with_holes border;
             Plane_3 supporting_plane;
 
+            void rasterize_exact(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const height, std::size_t const width, double const pixel_size, PixelWindow const& window) const;
+            void rasterize_scanline(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const width, double const pixel_size, PixelWindow const& window) const;
+
             friend std::ostream & operator <<(std::ostream & os, FacePrint const& facet);
         };
         
         bool operator ==(FacePrint const& lhs, FacePrint const& rhs);
         bool operator !=(FacePrint const& lhs, FacePrint const& rhs);
+
+        /**
+         * Inexact copy of a non degenerate facet projection for the scanline rasterizer.
+         * The supporting plane and the border edges are converted to doubles once,
+         * so that it can be rasterized concurrently without touching the exact kernel.
+         */
+        class ScanlinePrint
+        {
+        public:
+            ScanlinePrint(FacePrint const& facet);
+
+            Bbox_2 const& bbox(void) const noexcept;
+
+            /**
+             * Adds the facet heights at pixel centers to a raster window.
+             * The buffers start at the window top left pixel and their rows are `stride` pixels apart,
+             * so they can be either a whole raster or a single block of it.
+             * The heights of a pixel do not depend on the window, so tiled rasters are the same as whole ones bit for bit.
+             * @param image running mean heights of the window
+             * @param hits number of facets averaged in each pixel of the window
+             * @param stride distance between two rows of the buffers
+             * @param top_left top left corner of the raster
+             * @param pixel_size pixel size
+             * @param window pixels to fill, in raster coordinates
+             */
+            void rasterize(double* image, short* hits, std::size_t const stride, shadow::Point const& top_left, double const pixel_size, PixelWindow const& window) const;
+        private:
+            /** Non horizontal edge oriented upwards: x_low, y_low, x_high, y_high */
+            using Edge = std::array<double, 4>;
+
+            /** Plane height: alpha + beta * x + gamma * y */
+            double alpha;
+            double beta;
+            double gamma;
+            std::vector<Edge> edges;
+            Bbox_2 box;
+        };
     }
     void swap(projection::FacePrint & lhs, projection::FacePrint & rhs);
     
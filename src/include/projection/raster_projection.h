@@ -15,11 +15,71 @@ namespace city
 {
     namespace projection
     {
+        /**
+         * Raster sample types written to files.
+         */
+        enum class SampleType
+        {
+            float64,
+            float32,
+            int16,
+            int32
+        };
+
+        /**
+         * Sample type of a raster file, with the scale and offset of quantized heights:
+         * height = sample * scale + offset.
+         * The scale and offset are recorded in the band metadata so that reading a file back gives heights.
+         */
+        struct SampleFormat
+        {
+            SampleFormat(SampleType const _type = SampleType::float64, double const _scale = 1., double const _offset = 0.);
+
+            SampleType type;
+            double scale;
+            double offset;
+
+            GDALDataType gdal_type(void) const;
+            /**
+             * Converts heights to samples, rounding them for integer types.
+             * Out of range samples are clamped by GDAL when written.
+             * @param heights heights converted in place
+             */
+            void encode(std::vector<double> & heights) const;
+            /**
+             * Converts samples back to heights.
+             * @param samples samples converted in place
+             */
+            void decode(std::vector<double> & samples) const;
+            /**
+             * Records the scale and offset in a raster band.
+             * @param band GDAL raster band
+             */
+            void to_gdal(GDALRasterBand* band) const;
+            /**
+             * Reads the sample format of a raster band.
+             * Sample types that are not handled are read as float64.
+             * @param band GDAL raster band
+             * @return the band sample format
+             */
+            static SampleFormat from_gdal(GDALRasterBand* band);
+        };
+
         class RasterPrint
         {
         public:
             RasterPrint(void);
-            RasterPrint(FootPrint const& footprint, double _pixel_size);
+            /**
+             * Rasterizes a footprint.
+             * The raster is split in tiles, each tile being filled with the facets overlapping it, in the footprint order.
+             * Tiles are disjoint so they are filled concurrently, and the result is the same whatever the number of workers.
+             * The exact mode shares the exact facets between tiles, so it always runs on a single thread.
+             * @param footprint the footprint to rasterize
+             * @param _pixel_size pixel size
+             * @param mode rasterization algorithm
+             * @param workers number of threads, 0 meaning all hardware threads
+             */
+            RasterPrint(FootPrint const& footprint, double _pixel_size, Rasterization const mode = Rasterization::exact, std::size_t const workers = 1);
             RasterPrint(std::string const& filename, GDALDataset* raster_file);
             RasterPrint(RasterPrint const& other);
             RasterPrint(RasterPrint && other);
@@ -35,6 +95,8 @@ namespace city
             std::size_t get_height(void) const noexcept;
             std::size_t get_width(void) const noexcept;
             double const& get_pixel_size() const noexcept;
+            SampleFormat const& get_sample_format(void) const noexcept;
+            void set_sample_format(SampleFormat const& format) noexcept;
 
             std::size_t get_index(std::size_t const& i, std::size_t const& j) const noexcept;
             double* data(void) noexcept;
@@ -67,6 +129,8 @@ namespace city
             std::vector<double> image_matrix;
             std::vector<short> pixel_hits;
             bool offset = false;
+            SampleFormat sample_format;
+
 
             friend std::ostream & operator <<(std::ostream & os, RasterPrint const& raster_projection);
 
@@ -79,6 +143,47 @@ namespace city
         };
 
         bool operator !=(RasterPrint & lhs, RasterPrint const& rhs);
+
+        /** Tile side in pixels: a tile of heights and hits fits in a per core cache */
+        const std::size_t raster_tile_size = 128;
+
+        /**
+         * Splits a raster in tiles, row by row.
+         * @param height raster height
+         * @param width raster width
+         * @param tile_height tile height
+         * @param tile_width tile width
+         * @return the tile windows, border tiles being cropped to the raster
+         */
+        std::vector<PixelWindow> tile(std::size_t const height, std::size_t const width, std::size_t const tile_height, std::size_t const tile_width);
+
+        /**
+         * Bins bounding boxes in the tiles they overlap.
+         * Boxes are visited in order so that each bin keeps the input order.
+         * A one pixel margin is added since the exact rasterizer aligns its pixels on the facet bounding box.
+         * @param boxes facet bounding boxes
+         * @param top_left top left corner of the raster
+         * @param pixel_size pixel size
+         * @param height raster height
+         * @param width raster width
+         * @param tile_height tile height
+         * @param tile_width tile width
+         * @return for each tile of `tile(height, width, tile_height, tile_width)`, the overlapping box positions
+         */
+        std::vector< std::vector<std::size_t> > bin(std::vector<Bbox_2> const& boxes, shadow::Point const& top_left, double const pixel_size, std::size_t const height, std::size_t const width, std::size_t const tile_height, std::size_t const tile_width);
+
+        /**
+         * Rasterizes a footprint straight into a GDAL raster, one block at a time, with the scanline algorithm.
+         * Blocks follow the raster band block size; only one block per worker is held in memory,
+         * and blocks are written with GDAL block I/O as soon as they are filled.
+         * The pixels are the same as the ones of the in-memory RasterPrint.
+         * @param footprint the footprint to rasterize
+         * @param pixel_size pixel size
+         * @param file a GDAL dataset with one band, sized for the footprint bounding box;
+         *  its sample type, scale and offset give the sample format
+         * @param workers number of threads, 0 meaning all hardware threads
+         */
+        void stream_raster(FootPrint const& footprint, double const pixel_size, GDALDataset* file, std::size_t const workers = 1);
     }
     void swap(projection::RasterPrint & lhs, projection::RasterPrint & rhs);
 }
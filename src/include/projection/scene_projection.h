@@ -46,6 +46,7 @@ namespace city
             const_iterator cend(void) const noexcept;
 
             FootPrint & operator +=(FootPrint const& other);
+            FootPrint & operator +=(FootPrint && other);
 
             void to_ogr(GDALDataset* file, bool labels) const;
         private:
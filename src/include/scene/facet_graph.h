@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace city
+{
+    namespace scene
+    {
+        /**
+         * @ingroup scene
+         * @brief Facet dual graph stored in compressed sparse row form.
+         *
+         * Facets are numbered by their position in the surface facet list.
+         * The neighbours of facet `i` are `neighbours[offsets[i]]` to `neighbours[offsets[i + 1] - 1]`, sorted and without self loops.
+         */
+        struct FacetGraph
+        {
+            /** Row offsets: one per facet plus the total number of neighbours */
+            std::vector<std::size_t> offsets{0};
+            /** Concatenated neighbour lists */
+            std::vector<std::size_t> neighbours;
+
+            /**
+             * Number of facets
+             * @return the number of vertices of the dual graph
+             */
+            std::size_t size(void) const noexcept
+            {
+                return offsets.size() - 1;
+            }
+            /**
+             * Number of undirected edges
+             * @return the number of pairs of adjacent facets
+             */
+            std::size_t edges_size(void) const noexcept
+            {
+                return neighbours.size() / 2;
+            }
+
+            /**
+             * Neighbours of a facet
+             * @param facet facet position
+             * @return iterator to the first neighbour of the facet
+             */
+            std::vector<std::size_t>::const_iterator neighbours_cbegin(std::size_t const facet) const
+            {
+                return std::next(std::begin(neighbours), static_cast<long>(offsets[facet]));
+            }
+            /**
+             * Neighbours of a facet
+             * @param facet facet position
+             * @return iterator past the last neighbour of the facet
+             */
+            std::vector<std::size_t>::const_iterator neighbours_cend(std::size_t const facet) const
+            {
+                return std::next(std::begin(neighbours), static_cast<long>(offsets[facet + 1]));
+            }
+
+            /**
+             * Expands the graph to a dense row major adjacency matrix.
+             * The diagonal is set, as every facet is adjacent to itself.
+             * @return the size() x size() matrix
+             */
+            std::vector<bool> dense(void) const
+            {
+                std::vector<bool> matrix(size() * size(), false);
+                for(std::size_t row(0); row != size(); ++row)
+                {
+                    matrix[row * size() + row] = true;
+                    std::for_each(
+                        neighbours_cbegin(row),
+                        neighbours_cend(row),
+                        [&matrix, row, this](std::size_t const column)
+                        {
+                            matrix[row * size() + column] = true;
+                        }
+                    );
+                }
+                return matrix;
+            }
+        };
+    }
+}
@@ -23,12 +23,53 @@ namespace city
              * @see ~Scene(void);
              */
             Scene(void);
+            /**
+             * Constructor from meshes, converting them serially.
+             * @param building_meshes building meshes
+             * @param terrain_mesh terrain mesh
+             * @param _pivot pivot point
+             * @param _epsg_index EPSG projection system code
+             * @see Scene(std::vector<shadow::Mesh> && building_meshes, shadow::Mesh && terrain_mesh, city::shadow::Point const& _pivot, unsigned short _epsg_index, std::size_t const workers);
+             */
             Scene(
                 std::vector<shadow::Mesh> const& building_meshes,
                 shadow::Mesh const& terrain_mesh,
                 city::shadow::Point const& _pivot = shadow::Point(),
                 unsigned short _epsg_index = 2154
             );
+            /**
+             * Constructor from meshes, converting them to nodes on a bounded pool of threads.
+             * The terrain is one more work item, so it is converted concurrently with the buildings.
+             * Each mesh is moved out of the input and released as soon as its node is built.
+             * @param building_meshes building meshes, consumed
+             * @param terrain_mesh terrain mesh, consumed
+             * @param _pivot pivot point
+             * @param _epsg_index EPSG projection system code
+             * @param workers number of threads, 0 meaning all hardware threads
+             * @param weld_tolerance tolerance of the point welding applied to each mesh before its conversion, or no_welding
+             * @see shadow::Mesh::weld(double const tolerance)
+             */
+            Scene(
+                std::vector<shadow::Mesh> && building_meshes,
+                shadow::Mesh && terrain_mesh,
+                city::shadow::Point const& _pivot = shadow::Point(),
+                unsigned short _epsg_index = 2154,
+                std::size_t const workers = 1,
+                double const weld_tolerance = no_welding
+            );
+            /**
+             * Constructor from already built nodes.
+             * @param _buildings building nodes, moved into the scene
+             * @param _terrain terrain node, moved into the scene
+             * @param _pivot pivot point
+             * @param _epsg_index EPSG projection system code
+             */
+            Scene(
+                std::vector<UNode> && _buildings,
+                UNode && _terrain,
+                city::shadow::Point const& _pivot = shadow::Point(),
+                unsigned short _epsg_index = 2154
+            );
             /**
              * Copy Constructor.
              * @param other Scene to copy
@@ -107,7 +148,17 @@ namespace city
 
             std::size_t size(void) const noexcept;
 
-            Scene & prune(bool const terrain);
+            /**
+             * Prunes the building surfaces, and the terrain if asked, on a bounded pool of threads.
+             * Buildings are independent work items; the terrain, usually the largest surface, is handed out first.
+             * @param terrain whether to prune the terrain as well
+             * @param workers number of threads, 0 meaning all hardware threads
+             * @return the pruned scene
+             */
+            Scene & prune(bool const terrain, std::size_t const workers = 1);
+
+            /** Negative welding tolerance: meshes are converted as they are */
+            static const double no_welding;
         private:
             /** Pivot */
             city::shadow::Point pivot;
@@ -128,5 +179,5 @@ namespace city
         void swap(Scene & lhs, Scene & rhs);
     }
 
-    scene::Scene & prune(scene::Scene & scene, bool const terrain = false);
+    scene::Scene & prune(scene::Scene & scene, bool const terrain = false, std::size_t const workers = 1);
 }
@@ -4,6 +4,9 @@
 
 #include <shadow/point.h>
 #include <shadow/mesh.h>
+#include <shadow/flat_mesh.h>
+
+#include <scene/facet_graph.h>
 
 #include <io/Adjacency_stream/adjacency_stream.h>
 
@@ -29,6 +32,19 @@ namespace city
                 shadow::Point const& _reference_point=shadow::Point(),
                 unsigned short const _epsg_index=2154
             );
+            /**
+             * Constructor from a flat mesh.
+             * The surface is built straight from the flat buffers, without a per facet polygon soup,
+             * unless the facets are not consistently oriented: they are then reoriented as in the Mesh constructor.
+             * @param mesh the flat mesh
+             * @param _reference_point pivot point
+             * @param _epsg_index EPSG projection system code
+             */
+            UNode(
+                shadow::FlatMesh const& mesh,
+                shadow::Point const& _reference_point=shadow::Point(),
+                unsigned short const _epsg_index=2154
+            );
             UNode(
                 std::string const& node_id,
                 std::vector<shadow::Mesh> const& meshes,
@@ -42,6 +58,24 @@ namespace city
                 shadow::Point const& _reference_point=shadow::Point(),
                 unsigned short const _epsg_index=2154
             );
+            /**
+             * Constructor from the facets of an existing surface, e.g. reloaded from a scene cache.
+             * The polygons are trusted to be consistently and outward oriented: they are neither reoriented nor checked.
+             * @param node_id node name
+             * @param points surface points
+             * @param polygons surface facets, in facet order
+             * @param facet_ids facet ids in facet order, or empty to keep the default ids
+             * @param _reference_point pivot point
+             * @param _epsg_index EPSG projection system code
+             */
+            UNode(
+                std::string const& node_id,
+                std::vector<Point_3> const& points,
+                std::vector< std::vector<std::size_t> > const& polygons,
+                std::vector<std::size_t> const& facet_ids,
+                shadow::Point const& _reference_point=shadow::Point(),
+                unsigned short const _epsg_index=2154
+            );
             ~UNode(void);
 
             void swap(UNode & other);
@@ -258,6 +292,15 @@ namespace city
             */
             UNode::Halfedge_iterator prunable(void);
 
+            /**
+            * Joins every pair of adjacent facets with parallel normals, as repeatedly joining `prunable()` would.
+            * Facet normals are computed once and cached; after each join only the halfedges around the merged facet are re-examined.
+            * Candidates are taken in halfedge list order, so the resulting topology is the same as the `prunable()` loop.
+            * Halfedge and facet ids are overwritten.
+            * @return `this` urban node modified
+            */
+            UNode & merge_coplanar_facets(void);
+
             /** 
             * Finds all joinable halfedges.
             * @param facet a urban node facet
@@ -267,6 +310,7 @@ namespace city
 
             /** 
             * Clusters all facets into prunable facet bags.
+            * Edges are deduplicated by their endpoints through a hash set, vertex ids being overwritten by point ids.
             * @return a vector of all pruning halfedges
             */
             std::vector<UNode::Halfedge_handle> pruning_halfedges(void);
@@ -289,8 +333,21 @@ namespace city
             std::vector<UNode::Facet_const_handle> facet_adjacents(UNode::Facet const& facet) const;
             std::vector<UNode::Facet_const_handle> facet_handles(void) const;
             /** 
+            * Builds the sparse facet dual graph in a single pass over the facets.
+            * @return the facet adjacency in compressed sparse row form
+            */
+            FacetGraph facet_adjacency(void) const;
+            /** 
+            * Computes the facet attributes written with the dual graph, one row per facet:
+            * id, degree, area, circumference, centroid coordinates and normal coordinates.
+            * @return the row major attribute matrix of `facet_attributes_size` columns
+            */
+            std::vector<double> facet_attributes(void) const;
+            /** Number of attributes per facet */
+            static const std::size_t facet_attributes_size;
+            /** 
             * Write facet adjacency matrix to building matrix
-            * @return the adjacency matrix of facets
+            * @return the dense adjacency matrix of facets
             */
             std::vector<bool> facet_adjacency_matrix(void) const;
         private:
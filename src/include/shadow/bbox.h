@@ -3,7 +3,6 @@
 #include <CGAL/Bbox_3.h>
 
 #include <array>
-#include <valarray>
 #include <ostream>
 
 namespace city
@@ -49,7 +48,7 @@ namespace city
              * @see Bbox(double xmin, double xmax, double ymin, double ymax, double zmin, double zmax);
              * @see ~Bbox(void)
              */
-            Bbox(std::valarray<double> const& coordinates);
+            Bbox(std::array<double, 3> const& coordinates);
             /**
              * Bbox constructor from Point.
              * @see Bbox(void);
@@ -0,0 +1,174 @@
+#pragma once
+
+/**
+ * \file flat_mesh.h
+ * \brief Shadow FlatMesh definition
+ */
+
+
+#include <shadow/mesh.h>
+
+#include <geometry_definitions.h>
+
+#include <cstdint>
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <stdexcept>
+
+namespace city
+{
+    namespace scene
+    {
+        class UNode;
+    }
+
+    namespace shadow
+    {
+        /**
+         * @ingroup shadow_group
+         * @brief Mesh stored in flat arrays.
+         *
+         * The coordinates are three contiguous arrays and the faces share a single index buffer, in compressed sparse row form:
+         * the points of face `f` are `indices[offsets[f]]` to `indices[offsets[f + 1] - 1]`.
+         * Filling it allocates nothing per point or per face, unlike Mesh whose faces each own their index vector.
+         * Indices are 32 bits wide, which limits a mesh to 2^32 - 1 points and face indices.
+         */
+        class FlatMesh
+        {
+        public:
+            FlatMesh(void);
+            explicit FlatMesh(std::string const& _name);
+            /**
+             * Conversion from a Mesh.
+             * @param mesh the mesh to flatten
+             * @see to_mesh(void)
+             */
+            explicit FlatMesh(Mesh const& mesh);
+            FlatMesh(std::string const& _name, Polyhedron const& polyhedron);
+            explicit FlatMesh(scene::UNode const& unode);
+
+            /**
+             * Reserves storage ahead of filling.
+             * @param points expected number of points
+             * @param faces expected number of faces
+             * @param indices expected total number of face indices
+             */
+            void reserve(std::size_t const points, std::size_t const faces, std::size_t const indices);
+            /**
+             * Appends a point.
+             * @param x first coordinate
+             * @param y second coordinate
+             * @param z third coordinate
+             */
+            void add_point(double const x, double const y, double const z);
+            void add_point(Point const& point);
+            /**
+             * Appends a face.
+             * @tparam InputIterator iterator on unsigned point indices
+             * @param first first point index of the face
+             * @param last past the last point index of the face
+             */
+            template<typename InputIterator>
+            void add_face(InputIterator first, InputIterator last)
+            {
+                for(; first != last; ++first)
+                {
+                    if(static_cast<std::size_t>(*first) >= points_size())
+                    {
+                        indices.resize(offsets.back());
+                        throw std::out_of_range("The face refers to a missing point!");
+                    }
+                    indices.push_back(static_cast<std::uint32_t>(*first));
+                }
+                offsets.push_back(checked_index(indices.size()));
+            }
+
+            /**
+             * Name the mesh
+             */
+            void set_name(std::string const& _name);
+            std::string const& get_name(void) const noexcept;
+
+            std::size_t points_size(void) const noexcept;
+            std::size_t faces_size(void) const noexcept;
+            std::size_t indices_size(void) const noexcept;
+            bool is_empty(void) const noexcept;
+
+            /**
+             * Access the coordinate arrays.
+             * @return one coordinate of every point
+             */
+            std::vector<double> const& get_x(void) const noexcept;
+            std::vector<double> const& get_y(void) const noexcept;
+            std::vector<double> const& get_z(void) const noexcept;
+            /**
+             * Access the face index buffer.
+             * @return the concatenated face indices
+             */
+            std::vector<std::uint32_t> const& get_indices(void) const noexcept;
+            /**
+             * Access the face offsets.
+             * @return the first index of every face, followed by the size of the index buffer
+             */
+            std::vector<std::uint32_t> const& get_offsets(void) const noexcept;
+
+            /**
+             * Access a point.
+             * @param index point index
+             * @return the point
+             */
+            Point point(std::size_t const index) const;
+            /**
+             * Number of points of a face.
+             * @param face face index
+             * @return the face degree
+             */
+            std::size_t face_degree(std::size_t const face) const;
+            /**
+             * Access the indices of a face.
+             * @param face face index
+             * @return pointer to the first index of the face
+             */
+            std::uint32_t const* face_cbegin(std::size_t const face) const;
+            /**
+             * Access the indices of a face.
+             * @param face face index
+             * @return pointer past the last index of the face
+             */
+            std::uint32_t const* face_cend(std::size_t const face) const;
+
+            /**
+             * Computes the bounding box.
+             * @return the bounding box of the points
+             */
+            Bbox bbox(void) const;
+
+            std::vector<Point_3> get_cgal_points(void) const;
+            std::vector< std::vector<std::size_t> > get_cgal_faces(void) const;
+
+            /**
+             * Conversion to a Mesh.
+             * @return the mesh with the same points and faces
+             */
+            Mesh to_mesh(void) const;
+        private:
+            /** Mesh name */
+            std::string name;
+            /** Coordinates */
+            std::vector<double> x, y, z;
+            /** Concatenated face indices */
+            std::vector<std::uint32_t> indices;
+            /** Face offsets in the index buffer */
+            std::vector<std::uint32_t> offsets{0};
+
+            static std::uint32_t checked_index(std::size_t const size)
+            {
+                if(size > std::numeric_limits<std::uint32_t>::max())
+                    throw std::overflow_error("Too many points or face indices for a flat mesh!");
+                return static_cast<std::uint32_t>(size);
+            }
+        };
+    }
+}
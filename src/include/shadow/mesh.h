@@ -18,6 +18,7 @@
 #include <geometry_definitions.h>
 
 #include <map>
+#include <vector>
 #include <string>
 #include <ostream>
 
@@ -117,6 +118,14 @@ namespace city
              * @see ~Mesh(void);
              */
             Mesh(std::string const& _name, std::vector<Point> const& _points, std::vector<Face> const& _faces);
+            /**
+             * General constructor, taking over the points and facets.
+             * @param _name mesh name
+             * @param _points points coordinates
+             * @param _faces facets
+             * @see Mesh(std::string const& _name, std::vector<Point> const& _points, std::vector<Face> const& _faces);
+             */
+            Mesh(std::string const& _name, std::vector<Point> && _points, std::vector<Face> && _faces);
             /**
              * General constructor. 
              * @param _points points coordinates
@@ -218,7 +227,7 @@ namespace city
             /**
              * Name the mesh
              */
-            Mesh set_name(std::string const& _name) noexcept;
+            Mesh & set_name(std::string const& _name) noexcept;
 
             /**
              * Access Mesh name
@@ -257,6 +266,46 @@ namespace city
 
             Mesh & operator +=(Mesh const& other);
 
+            /**
+             * Concatenates many meshes at once.
+             * The result is the same as summing the meshes in order with operator+(),
+             * but the points and facets are counted first and stored once instead of being copied again at each addition.
+             * Meshes behind move iterators are moved in.
+             * @tparam ForwardIterator iterator on meshes
+             * @param first first mesh
+             * @param last past the last mesh
+             * @return the concatenated mesh
+             */
+            template<typename ForwardIterator>
+            static Mesh concatenate(ForwardIterator first, ForwardIterator last)
+            {
+                std::size_t points_total(0), faces_total(0);
+                for(ForwardIterator part = first; part != last; ++part)
+                {
+                    Mesh const& mesh = *part;
+                    points_total += mesh.points_size();
+                    faces_total += mesh.faces_size();
+                }
+
+                Mesh result;
+                result.points.reserve(points_total);
+                result.faces.reserve(faces_total);
+                for(; first != last; ++first)
+                    result.append(*first);
+                return result;
+            }
+
+            /**
+             * Welds the points closer than a tolerance.
+             * Points are hashed into a grid of cells `4 * tolerance` wide, so that each point is only compared to the points of the cells within `tolerance` of it.
+             * A point closer than `tolerance` to an earlier kept point is replaced by it in the faces, the kept points staying in their original order.
+             * Repeated consecutive indices are removed from the faces, and faces left with less than three points are dropped.
+             * @param tolerance largest distance between welded points, 0 welding only identical points
+             * @return reference to the welded mesh
+             * @throws std::out_of_range if the tolerance is negative or too small for the coordinates
+             */
+            Mesh & weld(double const tolerance);
+
             /**
              * Returns 3ds mesh structure.
              * @return pointer to `Lib3dsMesh`
@@ -274,6 +323,15 @@ namespace city
 
             /** Compute bounding box internal method*/
             void compute_bbox(void);
+            /**
+             * Appends a mesh without reallocating when the storage was reserved.
+             * @param other the mesh to append
+             * @see concatenate(ForwardIterator, ForwardIterator)
+             */
+            void append(Mesh const& other);
+            void append(Mesh && other);
+            /** Merges the name and bounding box of an appended mesh and offsets its facets, already appended */
+            void merge_appended(Mesh const& other, std::size_t const diff, std::size_t const shift);
 
             /** 
              * Writes Mesh to output stream.
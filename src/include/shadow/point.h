@@ -4,6 +4,7 @@
 
 #include <lib3ds/mesh.h>
 
+#include <array>
 #include <valarray>
 #include <ostream>
 
@@ -19,7 +20,8 @@ namespace city
          * @brief Point class representing a 3D Point.
          * 
          * Shadow Point is member class of Shadow Mesh:
-         *  - It stores a 3d Point coordinates.
+         *  - It stores a 3d Point coordinates inline, so that it is trivially copyable
+         *    and that vectors of points are contiguous arrays of coordinates.
          */
         class Point
         {
@@ -30,12 +32,12 @@ namespace city
             Point(std::valarray<double> const& initializer);
             Point(Point_3 const& point);
             Point(Lib3dsPoint const& point);
-            Point(Point const& other);
-            Point(Point && other);
-            ~Point(void);
+            Point(Point const& other) = default;
+            Point(Point && other) = default;
+            ~Point(void) = default;
             
-            std::valarray<double> const& data(void) const noexcept;
-            std::valarray<double> & data(void) noexcept;
+            std::array<double, 3> const& data(void) const noexcept;
+            std::array<double, 3> & data(void) noexcept;
 
             double const& x(void) const noexcept;
             double const& y(void) const noexcept;
@@ -45,14 +47,14 @@ namespace city
             double & z(void) noexcept;
 
             void swap(Point & other);
-            Point & operator =(Point const& other) noexcept;
-            Point & operator =(Point && other) noexcept;
+            Point & operator =(Point const& other) noexcept = default;
+            Point & operator =(Point && other) noexcept = default;
 
             Point & operator +=(Vector const& translation);
 
             Bbox bbox(void) const;
         private:
-            std::valarray<double> coordinates;
+            std::array<double, 3> coordinates;
 
             friend Point operator +(Point const& lhs, Vector const& rhs);
             friend bool operator ==(Point const& lhs, Point const& rhs);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <valarray>
 #include <ostream>
 
@@ -17,12 +18,12 @@ namespace city
             Vector(double x, double y, double z);
             Vector(double coordinates[3]);
             Vector(std::valarray<double> const& initializer);
-            Vector(Vector const& other);
-            Vector(Vector && other);
-            ~Vector(void);
+            Vector(Vector const& other) = default;
+            Vector(Vector && other) = default;
+            ~Vector(void) = default;
 
-            std::valarray<double> const& data(void) const noexcept;
-            std::valarray<double> & data(void) noexcept;
+            std::array<double, 3> const& data(void) const noexcept;
+            std::array<double, 3> & data(void) noexcept;
 
             double const& x(void) const noexcept;
             double const& y(void) const noexcept;
@@ -33,8 +34,8 @@ namespace city
 
             void swap(Vector & other);
 
-            Vector & operator =(Vector const& other) noexcept;
-            Vector & operator =(Vector && other) noexcept;
+            Vector & operator =(Vector const& other) noexcept = default;
+            Vector & operator =(Vector && other) noexcept = default;
 
             Vector & operator +=(Vector const& other);
             Vector & operator *=(double const scalar);
@@ -43,7 +44,7 @@ namespace city
             Vector & operator ^=(Vector const& other);
 
         private:
-            std::valarray<double> coordinates;
+            std::array<double, 3> coordinates;
 
             friend bool operator ==(Vector const& lhs, Vector const& rhs);
             friend Vector operator +(Vector const& lhs, Vector const& rhs);
@@ -3,14 +3,17 @@
 #include "config.h"
 
 #include <shadow/mesh.h>
+#include <shadow/flat_mesh.h>
 
 #include <io/io.h>
 #include <io/io_off.h>
+#include <io/io_dual_graph.h>
 #include <io/io_obj.h>
 #include <io/io_3ds.h>
 #include <io/io_vector.h>
 #include <io/io_raster.h>
 #include <io/io_scene.h>
+#include <io/io_scene_cache.h>
 
 #include <scene/scene.h>
 
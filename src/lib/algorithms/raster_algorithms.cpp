@@ -0,0 +1,75 @@
+#include <algorithms/raster_algorithms.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CITY_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace city
+{
+    namespace
+    {
+        inline void accumulate_plane_pixels(double* image, short* hits, std::size_t const begin, std::size_t const end, double const z_first, double const z_step, std::size_t const first_column)
+        {
+            for(std::size_t k = begin; k < end; ++k)
+            {
+                double z = z_first + static_cast<double>(first_column + k) * z_step;
+                double h = static_cast<double>(hits[k]);
+                image[k] = (image[k] * h + z) / (h + 1.);
+                ++hits[k];
+            }
+        }
+
+#ifdef CITY_AVX2_DISPATCH
+        __attribute__((target("avx2")))
+        void accumulate_plane_row_avx2(double* image, short* hits, std::size_t const count, double const z_first, double const z_step, std::size_t const first_column)
+        {
+            __m256d const lanes = _mm256_set_pd(3., 2., 1., 0.),
+                          first = _mm256_set1_pd(z_first),
+                          step = _mm256_set1_pd(z_step),
+                          one = _mm256_set1_pd(1.);
+            __m128i const increment = _mm_set1_epi16(1);
+
+            std::size_t k = 0;
+            for(; k + 4 <= count; k += 4)
+            {
+                __m256d z = _mm256_add_pd(first, _mm256_mul_pd(_mm256_add_pd(_mm256_set1_pd(static_cast<double>(first_column + k)), lanes), step));
+
+                __m128i packed_hits = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(hits + k));
+                __m256d h = _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(packed_hits));
+
+                __m256d pixels = _mm256_loadu_pd(image + k);
+                pixels = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(pixels, h), z), _mm256_add_pd(h, one));
+
+                _mm256_storeu_pd(image + k, pixels);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(hits + k), _mm_add_epi16(packed_hits, increment));
+            }
+            accumulate_plane_pixels(image, hits, k, count, z_first, z_step, first_column);
+        }
+#endif
+    }
+
+    void accumulate_plane_row_scalar(double* image, short* hits, std::size_t const count, double const z_first, double const z_step, std::size_t const first_column)
+    {
+        accumulate_plane_pixels(image, hits, 0, count, z_first, z_step, first_column);
+    }
+
+    bool vectorized_plane_rows(void)
+    {
+#ifdef CITY_AVX2_DISPATCH
+        static bool const avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+#else
+        return false;
+#endif
+    }
+
+    void accumulate_plane_row(double* image, short* hits, std::size_t const count, double const z_first, double const z_step, std::size_t const first_column)
+    {
+#ifdef CITY_AVX2_DISPATCH
+        if(vectorized_plane_rows())
+            return accumulate_plane_row_avx2(image, hits, count, z_first, z_step, first_column);
+#endif
+        accumulate_plane_row_scalar(image, hits, count, z_first, z_step, first_column);
+    }
+}
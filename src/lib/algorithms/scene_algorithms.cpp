@@ -1,6 +1,11 @@
 #include <algorithms/scene_algorithms.h>
 
+#include <algorithms/parallel_algorithms.h>
+#include <algorithms/util_algorithms.h>
+
 #include <io/Adjacency_stream/adjacency_stream.h>
+#include <io/Buffered_stream/buffered_stream.h>
+#include <io/io_dual_graph.h>
 
 #include <io/io_raster.h>
 #include <io/io_vector.h>
@@ -9,19 +14,29 @@
 
 namespace city
 {
-    void save_building_duals(boost::filesystem::path const& root_path, scene::Scene const& scene)
+    void save_building_duals(boost::filesystem::path const& root_path, scene::Scene const& scene, io::AdjacencyFormat const format)
     {
         std::cout << "Saving brick duals... " << std::flush;
         boost::filesystem::path dual_dir(root_path / "dual_graphs");
         boost::filesystem::create_directory(dual_dir);
         for(auto const& building : scene)
         {
-            std::fstream adjacency_file(
-                boost::filesystem::path(dual_dir / (building.get_name() + ".txt")).string(),
-                std::ios::out
-            );
-            io::Adjacency_stream as(adjacency_file);
-            as << building;
+            if(format == io::AdjacencyFormat::binary)
+            {
+                io::DualGraphHandler(
+                    dual_dir / (building.get_name() + ".cdg"),
+                    std::map<std::string, bool>{{"write", true}}
+                ).write(building.facet_attributes(), scene::UNode::facet_attributes_size, building.facet_adjacency());
+            }
+            else
+            {
+                std::fstream adjacency_file(
+                    boost::filesystem::path(dual_dir / (building.get_name() + ".txt")).string(),
+                    std::ios::out
+                );
+                io::Adjacency_stream as(adjacency_file, format);
+                as << building;
+            }
         }
         std::cout << " Done." << std::flush << std::endl;
     }
@@ -45,10 +60,15 @@ namespace city
             auto areas = city::areas(projection);
             auto edges = city::edge_lengths(projection);
 
-            std::copy(std::begin(areas), std::end(areas), std::ostream_iterator<double>(attributes_file, " "));
-            attributes_file << std::endl;
-            std::copy(std::begin(edges), std::end(edges), std::ostream_iterator<double>(attributes_file, " "));
-            attributes_file << std::endl;
+            {
+                io::Buffered_stream out(attributes_file);
+                for(auto const area : areas)
+                    out << area << ' ';
+                out << '\n';
+                for(auto const edge : edges)
+                    out << edge << ' ';
+                out << '\n';
+            }
             attributes_file.close();
         }
         std::cout << "Done." << std::flush << std::endl;
@@ -67,15 +87,11 @@ namespace city
         }
         std::cout << "Done." << std::flush << std::endl;
     }
-    void save_scene_prints(boost::filesystem::path const& root_path, std::string const& filename, std::vector<projection::FootPrint> const& projections, bool const rasterize, double const pixel_size)
+    void save_scene_prints(boost::filesystem::path const& root_path, std::string const& filename, std::vector<projection::FootPrint> && projections, bool const rasterize, double const pixel_size, std::size_t const workers, projection::Rasterization const mode, projection::SampleFormat const& format)
     {
         std::cout << "Summing , rasterizing and saving scene projections... " << std::flush;
 
-        auto scene_projection = std::accumulate(
-            std::begin(projections),
-            std::end(projections),
-            city::projection::FootPrint()
-        );
+        auto scene_projection = sum_prints(std::move(projections), workers);
 
         city::io::VectorHandler(
             boost::filesystem::path(root_path / (filename + ".shp")),
@@ -84,49 +100,113 @@ namespace city
 
         if(rasterize)
         {
-            city::projection::RasterPrint global_rasta(scene_projection, pixel_size);
-
-            city::io::RasterHandler(
+            city::io::RasterHandler handler(
                 boost::filesystem::path(root_path / (filename + ".tiff")),
                 std::map<std::string,bool>{{"write", true}}
-            ).write(global_rasta);
+            );
+            /* The scene raster can be far bigger than memory: it is streamed block by block unless the exact reference is asked */
+            if(mode == projection::Rasterization::scanline)
+                handler.write(scene_projection, pixel_size, workers, format);
+            else
+            {
+                city::projection::RasterPrint global_rasta(scene_projection, pixel_size, mode, workers);
+                global_rasta.set_sample_format(format);
+                handler.write(global_rasta);
+            }
         }
 
         std::cout << "Done." << std::flush << std::endl;        
     }
 
-    std::vector<projection::FootPrint> orthoproject(scene::Scene const& scene, bool const terrain)
+    projection::FootPrint sum_prints(std::vector<projection::FootPrint> && projections, std::size_t const workers)
     {
-        std::cout << "Projecting... " << std::flush;
-        std::vector<projection::FootPrint> ortho_projections(scene.size() + static_cast<std::size_t>(terrain));
+        std::vector<Bbox_2> boxes(projections.size());
+        std::transform(
+            std::begin(projections),
+            std::end(projections),
+            std::begin(boxes),
+            [](projection::FootPrint const& footprint)
+            {
+                return footprint.bbox();
+            }
+        );
+        auto order = spatial_order(boxes);
+
+        /* Each node carries the smallest input position it covers, so that merges keep the input precedence */
+        using Node = std::pair<std::size_t, projection::FootPrint>;
+        std::vector<Node> level(projections.size());
         std::transform(
-            std::begin(scene),
-            std::end(scene),
-            std::begin(ortho_projections),
-            [](scene::UNode const& building)
+            std::begin(order),
+            std::end(order),
+            std::begin(level),
+            [&projections](std::size_t const index)
             {
-                return projection::FootPrint(building);
+                return Node(index, std::move(projections[index]));
             }
         );
-        if(terrain)
-            ortho_projections[scene.size()] = projection::FootPrint(scene.get_terrain());
+
+        while(level.size() > 1)
+        {
+            std::vector<Node> next_level((level.size() + 1) / 2);
+            parallel_for(
+                next_level.size(),
+                [&level, &next_level](std::size_t const index)
+                {
+                    Node & lhs = level[2 * index];
+                    if(2 * index + 1 != level.size())
+                    {
+                        Node & rhs = level[2 * index + 1];
+                        if(rhs.first < lhs.first)
+                            std::swap(lhs, rhs);
+                        lhs.second += std::move(rhs.second);
+                    }
+                    next_level[index] = std::move(lhs);
+                },
+                workers
+            );
+            level = std::move(next_level);
+        }
+
+        return level.empty() ? projection::FootPrint() : std::move(level.front().second);
+    }
+
+    std::vector<projection::FootPrint> orthoproject(scene::Scene const& scene, bool const terrain, std::size_t const workers)
+    {
+        std::cout << "Projecting... " << std::flush;
+        std::vector<projection::FootPrint> ortho_projections(scene.size() + static_cast<std::size_t>(terrain));
+        std::size_t const shift = terrain ? 1 : 0;
+        /* The terrain, usually the largest mesh, is handed out first and written to the last slot */
+        parallel_for(
+            ortho_projections.size(),
+            [&scene, &ortho_projections, shift](std::size_t const index)
+            {
+                if(index < shift)
+                    ortho_projections.back() = projection::FootPrint(scene.get_terrain());
+                else
+                    ortho_projections[index - shift] = projection::FootPrint(*std::next(std::begin(scene), static_cast<long>(index - shift)));
+            },
+            workers
+        );
         
         std::cout << "Done." << std::flush << std::endl;
 
         return ortho_projections;
     }
-    std::vector<projection::RasterPrint> rasterize_scene(std::vector<projection::FootPrint> const& projections, double const  pixel_size)
+    std::vector<projection::RasterPrint> rasterize_scene(std::vector<projection::FootPrint> const& projections, double const  pixel_size, projection::Rasterization const mode, std::size_t const workers, projection::SampleFormat const& format)
     {
         std::cout << "rasterizing projections... " << std::flush;
         std::vector<projection::RasterPrint> raster_projections(projections.size());
-        std::transform(
+        parallel_transform(
             std::begin(projections),
             std::end(projections),
             std::begin(raster_projections),
-            [pixel_size](projection::FootPrint const& projection)
+            [pixel_size, mode, &format](projection::FootPrint const& projection)
             {
-                return projection::RasterPrint(projection, pixel_size);
-            }
+                projection::RasterPrint raster_projection(projection, pixel_size, mode);
+                raster_projection.set_sample_format(format);
+                return raster_projection;
+            },
+            workers
         );
         std::cout << "Done." << std::flush << std::endl;
 
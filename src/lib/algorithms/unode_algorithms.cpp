@@ -68,15 +68,7 @@ namespace city
 
     scene::UNode & prune(scene::UNode & unode)
     {
-        auto halfedge_handle = unode.prunable();
-
-        while(halfedge_handle != unode.halfedges_end())
-        {
-            unode = unode.join_facet(halfedge_handle);
-            halfedge_handle = unode.prunable();
-        }
-
-        unode.stitch_borders().set_face_ids();
+        unode.merge_coplanar_facets().stitch_borders().set_face_ids();
         
         return unode;
     }
@@ -3,6 +3,12 @@
 #include <CGAL/centroid.h>
 
 #include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+#include <cstdint>
+#include <cmath>
 
 namespace city
 {
@@ -133,6 +139,74 @@ namespace city
 
         return lengths;
     }
+    std::vector<std::size_t> spatial_order(std::vector<Bbox_2> const& boxes)
+    {
+        auto is_empty = [](Bbox_2 const& box)
+        {
+            return !(box.xmin() <= box.xmax() && box.ymin() <= box.ymax());
+        };
+
+        Bbox_2 extent = std::accumulate(
+            std::begin(boxes),
+            std::end(boxes),
+            Bbox_2(
+                std::numeric_limits<double>::infinity(),
+                std::numeric_limits<double>::infinity(),
+                - std::numeric_limits<double>::infinity(),
+                - std::numeric_limits<double>::infinity()
+            ),
+            [&is_empty](Bbox_2 const& result, Bbox_2 const& box)
+            {
+                return is_empty(box) ? result : result + box;
+            }
+        );
+
+        /* Quantize the box centers on a 2^16 x 2^16 grid and interleave their bits */
+        auto quantize = [](double const value, double const low, double const high)
+        {
+            return high > low
+                ? static_cast<std::uint64_t>(std::floor((value - low) / (high - low) * 65535.))
+                : std::uint64_t(0);
+        };
+        auto spread = [](std::uint64_t value)
+        {
+            value = (value | (value << 8)) & 0x00FF00FFu;
+            value = (value | (value << 4)) & 0x0F0F0F0Fu;
+            value = (value | (value << 2)) & 0x33333333u;
+            value = (value | (value << 1)) & 0x55555555u;
+            return value;
+        };
+
+        std::vector<std::uint64_t> codes(boxes.size(), 0);
+        std::transform(
+            std::begin(boxes),
+            std::end(boxes),
+            std::begin(codes),
+            [&is_empty, &quantize, &spread, &extent](Bbox_2 const& box)
+            {
+                return is_empty(box)
+                    ? std::uint64_t(0)
+                    : (
+                        spread(quantize((box.xmin() + box.xmax()) / 2, extent.xmin(), extent.xmax()))
+                        |
+                        (spread(quantize((box.ymin() + box.ymax()) / 2, extent.ymin(), extent.ymax())) << 1)
+                    );
+            }
+        );
+
+        std::vector<std::size_t> order(boxes.size());
+        std::iota(std::begin(order), std::end(order), 0);
+        std::stable_sort(
+            std::begin(order),
+            std::end(order),
+            [&codes](std::size_t const lhs, std::size_t const rhs)
+            {
+                return codes[lhs] < codes[rhs];
+            }
+        );
+        return order;
+    }
+
     double circumference(Polygon const& polygon)
     {
         return std::accumulate(
@@ -48,7 +48,7 @@ namespace city
            lib3ds_file_free(file);
         }
 
-        scene::Scene T3DSHandler::get_scene(SceneTreeHandler const& scene_tree_file, bool from_xml)
+        scene::Scene T3DSHandler::get_scene(SceneTreeHandler const& scene_tree_file, bool from_xml, std::size_t const workers, double const weld_tolerance)
         {
             if(from_xml)
             {
@@ -64,13 +64,15 @@ namespace city
                     }
                 );
                 return scene::Scene(
-                    building_meshes,
+                    std::move(building_meshes),
                     mesh(
                         scene_tree_file.terrain_id(),
                         std::set<char>{'M'}
                     ).set_name("terrain"),
                     scene_tree_file.pivot(),
-                    scene_tree_file.epsg_index()
+                    scene_tree_file.epsg_index(),
+                    workers,
+                    weld_tolerance
                 );
             }
             else
@@ -78,14 +80,20 @@ namespace city
                     level_meshes(1, std::set<char>{{'T', 'F'}}),
                     level_terrain(1),
                     scene_tree_file.pivot(),
-                    scene_tree_file.epsg_index()
+                    scene_tree_file.epsg_index(),
+                    workers,
+                    weld_tolerance
                 );
         }
-        scene::Scene T3DSHandler::get_scene(void)
+        scene::Scene T3DSHandler::get_scene(std::size_t const workers, double const weld_tolerance)
         {
             return scene::Scene(
                 level_meshes(1, std::set<char>{{'T', 'F'}}),
-                level_terrain(1)
+                level_terrain(1),
+                shadow::Point(),
+                2154,
+                workers,
+                weld_tolerance
             );
         }
 
@@ -131,12 +139,12 @@ namespace city
         shadow::Mesh T3DSHandler::level_terrain(std::size_t const level)
         {
             auto terrain_meshes = level_meshes(level, std::set<char>{'M'});
-            return std::accumulate(
-                std::begin(terrain_meshes),
-                std::end(terrain_meshes),
-                shadow::Mesh(),
-                std::plus<shadow::Mesh>()
-            ).set_name("terrain");
+            auto terrain = shadow::Mesh::concatenate(
+                std::make_move_iterator(std::begin(terrain_meshes)),
+                std::make_move_iterator(std::end(terrain_meshes))
+            );
+            terrain.set_name("terrain");
+            return terrain;
         }
         std::vector<std::vector<shadow::Mesh> > T3DSHandler::raw_level_meshes(std::size_t const level, std::set<char> const& facet_types)
         {
@@ -193,15 +201,17 @@ namespace city
         {
             auto meshes = mesh_by_type(node_name, facet_types);
 
-            return std::accumulate(
-                std::begin(meshes),
-                std::end(meshes),
-                shadow::Mesh(),
-                [](shadow::Mesh const& lhs, std::pair<char, shadow::Mesh> const& rhs)
-                {
-                    return lhs + rhs.second;
-                }
-            ).set_name(node_name);
+            std::vector<shadow::Mesh> parts;
+            parts.reserve(meshes.size());
+            for(auto & type_mesh : meshes)
+                parts.push_back(std::move(type_mesh.second));
+
+            auto node_mesh = shadow::Mesh::concatenate(
+                std::make_move_iterator(std::begin(parts)),
+                std::make_move_iterator(std::end(parts))
+            );
+            node_mesh.set_name(node_name);
+            return node_mesh;
         }
         std::map<char, shadow::Mesh> T3DSHandler::mesh_by_type(std::string const& node_name, std::set<char> const& facet_types)
         {
@@ -209,11 +219,10 @@ namespace city
 
             std::map<char, shadow::Mesh> mesh_by_type;
 
-            for(auto const& pair_tm : meshes)
-                mesh_by_type[pair_tm.first] = std::accumulate(
-                    std::begin(pair_tm.second),
-                    std::end(pair_tm.second),
-                    shadow::Mesh()
+            for(auto & pair_tm : meshes)
+                mesh_by_type[pair_tm.first] = shadow::Mesh::concatenate(
+                    std::make_move_iterator(std::begin(pair_tm.second)),
+                    std::make_move_iterator(std::end(pair_tm.second))
                 );
             return mesh_by_type;
         }
@@ -0,0 +1,157 @@
+#include <io/io_dual_graph.h>
+
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <stdexcept>
+
+#include <cstring>
+
+namespace city
+{
+    namespace io
+    {
+        namespace
+        {
+            const char dual_graph_magic[4] = {'C', 'D', 'G', '\0'};
+
+            std::uint32_t checked_size(std::size_t const size, std::string const& what)
+            {
+                if(size > std::numeric_limits<std::uint32_t>::max())
+                    throw std::overflow_error("Too many " + what + " for the binary dual graph format!");
+                return static_cast<std::uint32_t>(size);
+            }
+        }
+
+        const std::uint32_t DualGraphHandler::version = 1;
+
+
+        DualGraph::DualGraph(void)
+            : header{{'\0', '\0', '\0', '\0'}, 0, 0, 0, 0, 0}
+        {}
+        DualGraph::DualGraph(boost::filesystem::path const& filepath)
+            : DualGraph()
+        {
+            std::ostringstream error_message;
+            if(boost::filesystem::file_size(filepath) < sizeof(DualGraphHeader))
+            {
+                error_message << "This file \"" << filepath.string() << "\" is too short to be a binary dual graph!";
+                throw std::runtime_error(error_message.str());
+            }
+
+            file.open(filepath.string());
+            std::memcpy(&header, file.data(), sizeof(DualGraphHeader));
+            if(std::memcmp(header.magic, dual_graph_magic, sizeof(dual_graph_magic)) != 0 || header.version != DualGraphHandler::version)
+            {
+                error_message << "This file \"" << filepath.string() << "\" is not a version " << DualGraphHandler::version << " binary dual graph!";
+                throw std::runtime_error(error_message.str());
+            }
+
+            std::size_t const attributes_bytes = static_cast<std::size_t>(header.facets) * header.attributes * sizeof(float),
+                              edges_bytes = static_cast<std::size_t>(header.edges) * 2 * sizeof(std::uint32_t);
+            if(file.size() != sizeof(DualGraphHeader) + attributes_bytes + edges_bytes)
+            {
+                error_message << "The size of \"" << filepath.string() << "\" does not match its dual graph header!";
+                throw std::runtime_error(error_message.str());
+            }
+
+            /* The header size keeps both arrays aligned on the page aligned mapping */
+            attribute_data = reinterpret_cast<float const*>(file.data() + sizeof(DualGraphHeader));
+            edge_data = reinterpret_cast<std::uint32_t const*>(file.data() + sizeof(DualGraphHeader) + attributes_bytes);
+        }
+
+        std::size_t DualGraph::facets_size(void) const noexcept
+        {
+            return header.facets;
+        }
+        std::size_t DualGraph::attributes_size(void) const noexcept
+        {
+            return header.attributes;
+        }
+        std::size_t DualGraph::edges_size(void) const noexcept
+        {
+            return header.edges;
+        }
+        float const* DualGraph::attributes(void) const noexcept
+        {
+            return attribute_data;
+        }
+        float DualGraph::attribute(std::size_t const facet, std::size_t const column) const
+        {
+            if(facet >= facets_size() || column >= attributes_size())
+                throw std::out_of_range("Dual graph attribute out of range!");
+            return attribute_data[facet * attributes_size() + column];
+        }
+        std::uint32_t const* DualGraph::edges(void) const noexcept
+        {
+            return edge_data;
+        }
+
+
+        DualGraphHandler::DualGraphHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes)
+            : FileHandler(_filepath, _modes)
+        {}
+        DualGraphHandler::~DualGraphHandler(void)
+        {}
+
+        DualGraph DualGraphHandler::read(void)
+        {
+            std::ostringstream error_message;
+
+            if(!modes["read"])
+            {
+                error_message << std::boolalpha << "The read mode is set to:" << modes["read"] << "! You should set it as follows: \'modes[\"read\"] = true\'";
+                boost::system::error_code ec(boost::system::errc::io_error, boost::system::system_category());
+                throw boost::filesystem::filesystem_error(error_message.str(), ec);
+            }
+            if(!boost::filesystem::is_regular_file(filepath))
+            {
+                error_message << "This file: " << filepath.string() << " cannot be found! You should check the file path.";
+                boost::system::error_code ec(boost::system::errc::no_such_file_or_directory, boost::system::system_category());
+                throw boost::filesystem::filesystem_error(error_message.str(), ec);
+            }
+
+            return DualGraph(filepath);
+        }
+
+        void DualGraphHandler::write(std::vector<double> const& attributes, std::size_t const columns, scene::FacetGraph const& graph)
+        {
+            if(!modes["write"])
+            {
+                std::ostringstream error_message;
+                error_message << std::boolalpha << "The write mode is set to:" << modes["write"] << "! You should set it as follows: \'modes[\"write\"] = true\'";
+                boost::system::error_code ec(boost::system::errc::io_error, boost::system::system_category());
+                throw boost::filesystem::filesystem_error(error_message.str(), ec);
+            }
+            if(attributes.size() != graph.size() * columns)
+                throw std::logic_error("There should be as many attribute rows as graph facets!");
+
+            std::vector<float> attribute_data(std::begin(attributes), std::end(attributes));
+
+            std::vector<std::uint32_t> edge_data;
+            edge_data.reserve(2 * graph.edges_size());
+            for(std::size_t row(0); row != graph.size(); ++row)
+                for(auto column = graph.neighbours_cbegin(row); column != graph.neighbours_cend(row); ++column)
+                    if(row < *column)
+                    {
+                        edge_data.push_back(static_cast<std::uint32_t>(row));
+                        edge_data.push_back(static_cast<std::uint32_t>(*column));
+                    }
+
+            DualGraphHeader header{
+                {dual_graph_magic[0], dual_graph_magic[1], dual_graph_magic[2], dual_graph_magic[3]},
+                version,
+                checked_size(graph.size(), "facets"),
+                checked_size(columns, "attributes"),
+                checked_size(edge_data.size() / 2, "edges"),
+                0
+            };
+
+            std::ofstream graph_file(filepath.string(), std::ios::out | std::ios::binary);
+            graph_file.exceptions(std::ios::failbit | std::ios::badbit);
+            graph_file.write(reinterpret_cast<char const*>(&header), sizeof(DualGraphHeader));
+            graph_file.write(reinterpret_cast<char const*>(attribute_data.data()), static_cast<std::streamsize>(attribute_data.size() * sizeof(float)));
+            graph_file.write(reinterpret_cast<char const*>(edge_data.data()), static_cast<std::streamsize>(edge_data.size() * sizeof(std::uint32_t)));
+        }
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <io/Obj_stream/obj_stream.h>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 #include <fstream>
 #include <sstream>
 
@@ -37,16 +39,38 @@ namespace city
         }
 
         WaveObjHandler& WaveObjHandler::read(void)
+        {
+            std::vector<shadow::FlatMesh> flat_meshes = read_flat();
+            meshes.resize(flat_meshes.size());
+            std::transform(
+                std::begin(flat_meshes),
+                std::end(flat_meshes),
+                std::begin(meshes),
+                [](shadow::FlatMesh const& flat_mesh)
+                {
+                    return flat_mesh.to_mesh();
+                }
+            );
+            return *this;
+        }
+
+        std::vector<shadow::FlatMesh> WaveObjHandler::read_flat(void)
         {
             std::ostringstream error_message;
+            std::vector<shadow::FlatMesh> flat_meshes;
 
             if (modes["read"])
             {
                 if (boost::filesystem::is_regular_file(filepath))
                 {
-                    std::fstream obj_file(filepath.string(), std::ios::in);
-                    Obj_stream object_stream(obj_file);
-                    object_stream >> meshes;
+                    /* Multi-GB exports are parsed in place from a memory mapping */
+                    if(boost::filesystem::file_size(filepath) == 0)
+                        flat_meshes = Obj_stream::parse_flat(nullptr, nullptr);
+                    else
+                    {
+                        boost::iostreams::mapped_file_source obj_file(filepath.string());
+                        flat_meshes = Obj_stream::parse_flat(obj_file.data(), obj_file.data() + obj_file.size());
+                    }
                 }
                 else
                 {
@@ -61,15 +85,15 @@ namespace city
                 boost::system::error_code ec(boost::system::errc::io_error, boost::system::system_category());
                 throw boost::filesystem::filesystem_error(error_message.str(), ec);
             }
-            return *this;
+            return flat_meshes;
         }
 
-        void WaveObjHandler::write(void)
+        void WaveObjHandler::write(int const decimals)
         {
             if (modes["write"])
             {
                     std::fstream obj_file(filepath.string(), std::ios::out);
-                    Obj_stream object_stream(obj_file);
+                    Obj_stream object_stream(obj_file, decimals);
                     object_stream << meshes;
             }
             else
@@ -96,23 +120,28 @@ namespace city
                 std::make_move_iterator(std::end(meshes))
             );
             meshes.erase(part, std::end(meshes));
-            return std::accumulate(
-                std::begin(excluded_meshes),
-                std::end(excluded_meshes),
-                shadow::Mesh()
-            ).set_name(excluded);
+            auto excluded_mesh = shadow::Mesh::concatenate(
+                std::make_move_iterator(std::begin(excluded_meshes)),
+                std::make_move_iterator(std::end(excluded_meshes))
+            );
+            excluded_mesh.set_name(excluded);
+            return excluded_mesh;
         }
         void WaveObjHandler::add_mesh(shadow::Mesh const& mesh)
         {
             meshes.push_back(mesh);
         }
 
-        scene::Scene WaveObjHandler::get_scene(void)
+        scene::Scene WaveObjHandler::get_scene(std::size_t const workers, double const weld_tolerance)
         {
             auto terrain = read().exclude_mesh("terrain");
             return scene::Scene(
-                meshes,
-                terrain
+                std::move(meshes),
+                std::move(terrain),
+                shadow::Point(),
+                2154,
+                workers,
+                weld_tolerance
             );
         }
     }
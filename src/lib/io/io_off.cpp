@@ -2,6 +2,8 @@
 
 #include <io/Off_stream/off_stream.h>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 #include <stdexcept>
 
 #include <fstream>
@@ -18,18 +20,27 @@ namespace city
         {}
 
         shadow::Mesh OFFHandler::read(void)
+        {
+            return read_flat().to_mesh();
+        }
+
+        shadow::FlatMesh OFFHandler::read_flat(void)
         {
             std::ostringstream error_message;
 
-            shadow::Mesh mesh;
+            shadow::FlatMesh mesh;
 
             if (modes["read"])
             {
                 if (boost::filesystem::is_regular_file(filepath))
                 {
-                    std::fstream off_file(filepath.string(), std::ios::in);
-                    Off_stream off_stream(off_file);
-                    off_stream >> mesh;
+                    if(boost::filesystem::file_size(filepath) == 0)
+                        mesh = Off_stream::parse_flat(nullptr, nullptr);
+                    else
+                    {
+                        boost::iostreams::mapped_file_source off_file(filepath.string());
+                        mesh = Off_stream::parse_flat(off_file.data(), off_file.data() + off_file.size());
+                    }
                     mesh.set_name(filepath.stem().string());
                 }
                 else
@@ -49,12 +60,12 @@ namespace city
             return mesh;
         }
 
-        void OFFHandler::write(shadow::Mesh const& mesh)
+        void OFFHandler::write(shadow::Mesh const& mesh, int const decimals)
         {
             if (modes["write"])
             {
                     std::fstream off_file(filepath.string(), std::ios::out);
-                    Off_stream off_stream(off_file);
+                    Off_stream off_stream(off_file, decimals);
                     off_stream << mesh;
             }
             else
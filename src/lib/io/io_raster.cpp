@@ -1,7 +1,12 @@
 #include <io/io_raster.h>
 
+#include <cpl_string.h>
+
 #include <algorithm>
 #include <iterator>
+#include <string>
+
+#include <cmath>
 
 namespace city
 {
@@ -68,7 +73,7 @@ namespace city
                     static_cast<int>(raster_image.get_width()),
                     static_cast<int>(raster_image.get_height()),
                     1,
-                    GDT_Float64,
+                    raster_image.get_sample_format().gdal_type(),
                     nullptr
                 );
 
@@ -82,5 +87,63 @@ namespace city
                 throw boost::filesystem::filesystem_error(error_message.str(), ec);
             }
         }
+
+        void RasterHandler::write(projection::FootPrint const& footprint, double const pixel_size, std::size_t const workers, projection::SampleFormat const& format)
+        {
+            std::ostringstream error_message;
+
+            if (modes["write"])
+            {
+                GDALAllRegister();
+                GDALDriver* driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+                if(driver == nullptr)
+                {
+                    error_message << "GDAL could not find a driver for: GeoTiff";
+                    throw std::runtime_error(error_message.str());
+                }
+
+                std::string block_size = std::to_string(projection::raster_tile_size);
+                char** options = nullptr;
+                options = CSLSetNameValue(options, "TILED", "YES");
+                options = CSLSetNameValue(options, "BLOCKXSIZE", block_size.c_str());
+                options = CSLSetNameValue(options, "BLOCKYSIZE", block_size.c_str());
+                options = CSLSetNameValue(options, "COMPRESS", "DEFLATE");
+                options = CSLSetNameValue(options, "PREDICTOR", format.gdal_type() == GDT_Float32 || format.gdal_type() == GDT_Float64 ? "3" : "2");
+                options = CSLSetNameValue(options, "BIGTIFF", "IF_SAFER");
+
+                GDALDataset* file = driver->Create(
+                    filepath.string().c_str(),
+                    static_cast<int>(std::ceil((footprint.bbox().xmax() - footprint.bbox().xmin()) / pixel_size)),
+                    static_cast<int>(std::ceil((footprint.bbox().ymax() - footprint.bbox().ymin()) / pixel_size)),
+                    1,
+                    format.gdal_type(),
+                    options
+                );
+                CSLDestroy(options);
+                if(file == nullptr)
+                {
+                    error_message << "GDAL could not create: " << filepath.string();
+                    throw std::runtime_error(error_message.str());
+                }
+                format.to_gdal(file->GetRasterBand(1));
+
+                try
+                {
+                    projection::stream_raster(footprint, pixel_size, file, workers);
+                }
+                catch(...)
+                {
+                    GDALClose(dynamic_cast<GDALDatasetH>(file));
+                    throw;
+                }
+                GDALClose(dynamic_cast<GDALDatasetH>(file));
+            }
+            else
+            {
+                error_message << std::boolalpha << "The write mode is set to:" << modes["write"] << "! You should set it as follows: \'modes[\"write\"] = true\'";
+                boost::system::error_code ec(boost::system::errc::io_error, boost::system::system_category());
+                throw boost::filesystem::filesystem_error(error_message.str(), ec);
+            }
+        }
     }
 }
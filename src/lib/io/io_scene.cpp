@@ -4,10 +4,15 @@
 #include <io/io_3ds.h>
 #include <io/io_off.h>
 #include <io/io_obj.h>
+#include <io/io_scene_cache.h>
+
+#include <algorithms/parallel_algorithms.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/range/iterator_range.hpp>
 
+#include <iostream>
+
 #include <algorithm>
 #include <iterator>
 
@@ -15,15 +20,15 @@ namespace city
 {
     namespace io
     {
-        const std::vector<std::string> SceneHandler::supported_formats{{"3DS XML", "3DS", "OFF", "OBJ"}};
-        const std::vector<std::string> SceneHandler::supported_extentions{{".3ds", ".3ds", ".off", ".obj"}};
+        const std::vector<std::string> SceneHandler::supported_formats{{"3DS XML", "3DS", "OFF", "OBJ", "CACHE"}};
+        const std::vector<std::string> SceneHandler::supported_extentions{{".3ds", ".3ds", ".off", ".obj", ".cache"}};
 
 
-        SceneHandler::SceneHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes, std::string const& _format)
-            : SceneHandler(_filepath, _modes, SceneHandler::scene_format(_format))
+        SceneHandler::SceneHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes, std::string const& _format, std::size_t const _workers, double const _weld_tolerance)
+            : SceneHandler(_filepath, _modes, SceneHandler::scene_format(_format), _workers, _weld_tolerance)
         {}
-        SceneHandler::SceneHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes, SceneFormat const _format)
-            : FileHandler(_filepath, _modes), format(_format)
+        SceneHandler::SceneHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes, SceneFormat const _format, std::size_t const _workers, double const _weld_tolerance)
+            : FileHandler(_filepath, _modes), format(_format), workers(_workers), weld_tolerance(_weld_tolerance)
         {
             switch(format)
             {
@@ -37,6 +42,9 @@ namespace city
                     break;
                 case obj:
                     check_extension();
+                    break;
+                case cache:
+                    check_extension();
             }
         }
         SceneHandler::~SceneHandler(void)
@@ -51,15 +59,7 @@ namespace city
                     if(! boost::filesystem::is_directory(filepath))
                         throw std::runtime_error("Path is not a directory");
                     {
-                        std::vector<shadow::Mesh> buildings;
-                        buildings.reserve(
-                            static_cast<std::size_t>(
-                                std::distance(
-                                    boost::filesystem::directory_iterator(filepath),
-                                    boost::filesystem::directory_iterator()
-                                )
-                            )
-                        );
+                        std::vector<boost::filesystem::path> paths;
                         for(auto& file : boost::make_iterator_range(boost::filesystem::directory_iterator(filepath), {}))
                             if(
                                 boost::filesystem::is_regular_file(file)
@@ -71,17 +71,35 @@ namespace city
                                 &&
                                 file.path().stem().string() != "terrain"
                             )
-                                buildings.push_back(
-                                    OFFHandler(file, modes).read()
-                                );
+                                paths.push_back(file.path());
+                        /* Directory iteration order is unspecified */
+                        std::sort(std::begin(paths), std::end(paths));
+
+                        /* Each building is parsed and turned into a node by the same work item, so that only nodes are kept in memory */
+                        std::vector<scene::UNode> buildings(paths.size());
+                        ProgressCounter progress("Reading buildings... ", paths.size(), std::cout);
+                        parallel_for(
+                            paths.size(),
+                            [this, &paths, &buildings, &progress](std::size_t const index)
+                            {
+                                buildings[index] = read_node(paths[index]);
+                                progress();
+                            },
+                            workers
+                        );
+                        std::cout << "Done." << std::flush << std::endl;
+
                         scene = scene::Scene(
-                            buildings,
-                            OFFHandler(filepath / "terrain.off", modes).read()
+                            std::move(buildings),
+                            read_node(filepath / "terrain.off")
                         );
                     }
                     break;
                 case obj:
-                    scene = WaveObjHandler(filepath, modes).get_scene();
+                    scene = WaveObjHandler(filepath, modes).get_scene(workers, weld_tolerance);
+                    break;
+                case cache:
+                    scene = SceneCacheHandler(filepath, modes).read().to_scene(workers);
                     break;
                 case t3ds_xml:
                     scene = T3DSHandler(filepath, modes).get_scene(
@@ -90,7 +108,9 @@ namespace city
                             /
                             (filepath.stem().string() + ".XML")
                         ),
-                        true
+                        true,
+                        workers,
+                        weld_tolerance
                     );
                     break;
                 case t3ds:
@@ -102,13 +122,15 @@ namespace city
                                 /
                                 (filepath.stem().string() + ".XML")
                             ),
-                            false
+                            false,
+                            workers,
+                            weld_tolerance
                         );
                     }
                     catch(std::runtime_error const& err)
                     {
                         std::cerr << err.what() << std::endl;
-                        scene = T3DSHandler(filepath, modes).get_scene();
+                        scene = T3DSHandler(filepath, modes).get_scene(workers, weld_tolerance);
                     }
             }
             return scene;
@@ -143,6 +165,9 @@ namespace city
                 case obj:
                     WaveObjHandler(filepath, scene, modes).write();
                     break;
+                case cache:
+                    SceneCacheHandler(filepath, modes).write(scene);
+                    break;
                 case t3ds_xml:
                     throw std::logic_error("Not yet implemented");
                 case t3ds:
@@ -167,6 +192,14 @@ namespace city
             return supported_extentions.at(format);
         }
 
+        scene::UNode SceneHandler::read_node(boost::filesystem::path const& mesh_path) const
+        {
+            /* Welding works on meshes: only unwelded nodes are built straight from the flat buffers */
+            if(weld_tolerance >= 0)
+                return scene::UNode(OFFHandler(mesh_path, modes).read().weld(weld_tolerance));
+            return scene::UNode(OFFHandler(mesh_path, modes).read_flat());
+        }
+
         void SceneHandler::check_extension(void) const
         {
             if(
@@ -0,0 +1,318 @@
+#include <io/io_scene_cache.h>
+#include <io/io_scene.h>
+
+#include <shadow/flat_mesh.h>
+
+#include <algorithms/parallel_algorithms.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include <cstring>
+
+namespace city
+{
+    namespace io
+    {
+        namespace
+        {
+            const char scene_cache_magic[4] = {'C', 'S', 'C', '\0'};
+            const char padding[8] = {'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0'};
+
+            std::uint32_t checked_size(std::size_t const size, std::string const& what)
+            {
+                if(size > std::numeric_limits<std::uint32_t>::max())
+                    throw std::overflow_error("Too many " + what + " for the binary scene cache format!");
+                return static_cast<std::uint32_t>(size);
+            }
+
+            /** Rounds a size up to a multiple of 8 bytes */
+            std::size_t padded(std::size_t const size) noexcept
+            {
+                return (size + 7) & ~std::size_t(7);
+            }
+
+            /** Size of a record, past its SceneCacheRecord */
+            std::size_t record_bytes(SceneCacheRecord const& record) noexcept
+            {
+                return padded(record.name_size)
+                       + 3 * static_cast<std::size_t>(record.points) * sizeof(double)
+                       + padded((static_cast<std::size_t>(record.faces) + 1 + record.indices + record.facet_ids) * sizeof(std::uint32_t));
+            }
+
+            void write_node(std::ofstream & cache_file, scene::UNode const& unode, bool const facet_ids)
+            {
+                shadow::FlatMesh const mesh(unode);
+
+                std::vector<std::uint32_t> ids;
+                if(facet_ids)
+                {
+                    ids.reserve(mesh.faces_size());
+                    for(auto facet = unode.facets_cbegin(); facet != unode.facets_cend(); ++facet)
+                        ids.push_back(checked_size(facet->id(), "facet ids"));
+                }
+
+                SceneCacheRecord record{
+                    checked_size(mesh.get_name().size(), "name characters"),
+                    checked_size(mesh.points_size(), "points"),
+                    checked_size(mesh.faces_size(), "faces"),
+                    checked_size(mesh.indices_size(), "face indices"),
+                    checked_size(ids.size(), "facet ids"),
+                    0
+                };
+                cache_file.write(reinterpret_cast<char const*>(&record), sizeof(SceneCacheRecord));
+
+                cache_file.write(mesh.get_name().data(), static_cast<std::streamsize>(record.name_size));
+                cache_file.write(padding, static_cast<std::streamsize>(padded(record.name_size) - record.name_size));
+
+                for(auto const coordinates : {&mesh.get_x(), &mesh.get_y(), &mesh.get_z()})
+                    cache_file.write(reinterpret_cast<char const*>(coordinates->data()), static_cast<std::streamsize>(coordinates->size() * sizeof(double)));
+
+                std::size_t const integers_bytes = (mesh.get_offsets().size() + mesh.indices_size() + ids.size()) * sizeof(std::uint32_t);
+                cache_file.write(reinterpret_cast<char const*>(mesh.get_offsets().data()), static_cast<std::streamsize>(mesh.get_offsets().size() * sizeof(std::uint32_t)));
+                cache_file.write(reinterpret_cast<char const*>(mesh.get_indices().data()), static_cast<std::streamsize>(mesh.indices_size() * sizeof(std::uint32_t)));
+                cache_file.write(reinterpret_cast<char const*>(ids.data()), static_cast<std::streamsize>(ids.size() * sizeof(std::uint32_t)));
+                cache_file.write(padding, static_cast<std::streamsize>(padded(integers_bytes) - integers_bytes));
+            }
+        }
+
+        const std::uint32_t SceneCacheHandler::version = 2;
+
+
+        SceneCacheSource SceneCacheSource::stamp(boost::filesystem::path const& scene_path, std::uint32_t const format, double const weld_tolerance)
+        {
+            SceneCacheSource source{0, 0, weld_tolerance, format, 0};
+            auto add_file = [&source](boost::filesystem::path const& filepath)
+            {
+                source.last_write_time = std::max(source.last_write_time, static_cast<std::int64_t>(boost::filesystem::last_write_time(filepath)));
+                source.size += boost::filesystem::file_size(filepath);
+            };
+
+            /* Only the files the scene reader opens are stamped: outputs written next to the scene must not stale its cache */
+            if(boost::filesystem::is_directory(scene_path))
+            {
+                for(auto& file : boost::make_iterator_range(boost::filesystem::directory_iterator(scene_path), {}))
+                    if(
+                        boost::filesystem::is_regular_file(file)
+                        &&
+                        boost::iequals(
+                            file.path().extension().string(),
+                            SceneHandler::extension(static_cast<SceneFormat>(format))
+                        )
+                    )
+                        add_file(file.path());
+            }
+            else
+            {
+                add_file(scene_path);
+                boost::filesystem::path const scene_tree(scene_path.parent_path() / (scene_path.stem().string() + ".XML"));
+                if((format == SceneFormat::t3ds || format == SceneFormat::t3ds_xml) && boost::filesystem::is_regular_file(scene_tree))
+                    add_file(scene_tree);
+            }
+            return source;
+        }
+
+        bool operator ==(SceneCacheSource const& lhs, SceneCacheSource const& rhs) noexcept
+        {
+            return lhs.last_write_time == rhs.last_write_time
+                   && lhs.size == rhs.size
+                   && lhs.weld_tolerance == rhs.weld_tolerance
+                   && lhs.format == rhs.format;
+        }
+        bool operator !=(SceneCacheSource const& lhs, SceneCacheSource const& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+
+        SceneCache::SceneCache(void)
+            : header{{'\0', '\0', '\0', '\0'}, 0, 0, 0, 0, 0, {0., 0., 0.}, {0, 0, 0., 0, 0}}
+        {}
+        SceneCache::SceneCache(boost::filesystem::path const& filepath)
+            : SceneCache()
+        {
+            std::ostringstream error_message;
+            if(boost::filesystem::file_size(filepath) < sizeof(SceneCacheHeader))
+            {
+                error_message << "This file \"" << filepath.string() << "\" is too short to be a binary scene cache!";
+                throw std::runtime_error(error_message.str());
+            }
+
+            file.open(filepath.string());
+            std::memcpy(&header, file.data(), sizeof(SceneCacheHeader));
+            if(std::memcmp(header.magic, scene_cache_magic, sizeof(scene_cache_magic)) != 0 || header.version != SceneCacheHandler::version)
+            {
+                error_message << "This file \"" << filepath.string() << "\" is not a version " << SceneCacheHandler::version << " binary scene cache!";
+                throw std::runtime_error(error_message.str());
+            }
+
+            /* The header and record sizes, and the padding, keep every array aligned on the page aligned mapping */
+            records.reserve(static_cast<std::size_t>(header.buildings) + 1);
+            std::size_t position(sizeof(SceneCacheHeader));
+            for(std::size_t record(0); record != static_cast<std::size_t>(header.buildings) + 1; ++record)
+            {
+                if(file.size() < position + sizeof(SceneCacheRecord))
+                    break;
+                records.push_back(position);
+                position += sizeof(SceneCacheRecord) + record_bytes(*reinterpret_cast<SceneCacheRecord const*>(file.data() + position));
+            }
+            if(records.size() != static_cast<std::size_t>(header.buildings) + 1 || position != file.size())
+            {
+                error_message << "The size of \"" << filepath.string() << "\" does not match its scene cache records!";
+                throw std::runtime_error(error_message.str());
+            }
+        }
+
+        shadow::Point SceneCache::pivot(void) const noexcept
+        {
+            return shadow::Point(header.pivot[0], header.pivot[1], header.pivot[2]);
+        }
+        unsigned short SceneCache::epsg(void) const noexcept
+        {
+            return static_cast<unsigned short>(header.epsg);
+        }
+        std::size_t SceneCache::buildings_size(void) const noexcept
+        {
+            return header.buildings;
+        }
+        bool SceneCache::pruned_buildings(void) const noexcept
+        {
+            return (header.pruned & 1) != 0;
+        }
+        bool SceneCache::pruned_terrain(void) const noexcept
+        {
+            return (header.pruned & 2) != 0;
+        }
+        SceneCacheSource const& SceneCache::source(void) const noexcept
+        {
+            return header.source;
+        }
+
+        scene::UNode SceneCache::node(std::size_t const index) const
+        {
+            if(index >= records.size())
+                throw std::out_of_range("Scene cache node out of range!");
+
+            SceneCacheRecord record;
+            std::memcpy(&record, file.data() + records[index], sizeof(SceneCacheRecord));
+            char const* cursor = file.data() + records[index] + sizeof(SceneCacheRecord);
+
+            std::string name(cursor, record.name_size);
+            cursor += padded(record.name_size);
+
+            double const* x = reinterpret_cast<double const*>(cursor);
+            double const* y = x + record.points;
+            double const* z = y + record.points;
+            std::uint32_t const* offsets = reinterpret_cast<std::uint32_t const*>(z + record.points);
+            std::uint32_t const* indices = offsets + record.faces + 1;
+            std::uint32_t const* ids = indices + record.indices;
+
+            std::vector<Point_3> points;
+            points.reserve(record.points);
+            for(std::size_t point(0); point != record.points; ++point)
+                points.push_back(Point_3(x[point], y[point], z[point]));
+
+            std::vector< std::vector<std::size_t> > polygons(record.faces);
+            for(std::size_t face(0); face != record.faces; ++face)
+            {
+                if(offsets[face] > offsets[face + 1] || offsets[face + 1] > record.indices)
+                    throw std::runtime_error("Corrupted face offsets in the scene cache node \"" + name + "\"!");
+                polygons[face].assign(indices + offsets[face], indices + offsets[face + 1]);
+                for(auto const point : polygons[face])
+                    if(point >= record.points)
+                        throw std::runtime_error("Corrupted face indices in the scene cache node \"" + name + "\"!");
+            }
+
+            return scene::UNode(
+                name,
+                points,
+                polygons,
+                std::vector<std::size_t>(ids, ids + record.facet_ids),
+                pivot(),
+                epsg()
+            );
+        }
+
+        scene::Scene SceneCache::to_scene(std::size_t const workers) const
+        {
+            std::vector<scene::UNode> buildings(buildings_size());
+            scene::UNode terrain;
+            /* The terrain, usually the largest surface, is handed out first */
+            parallel_for(
+                buildings.size() + 1,
+                [this, &buildings, &terrain](std::size_t const index)
+                {
+                    if(index == 0)
+                        terrain = node(buildings_size());
+                    else
+                        buildings[index - 1] = node(index - 1);
+                },
+                workers
+            );
+            return scene::Scene(std::move(buildings), std::move(terrain), pivot(), epsg());
+        }
+
+
+        SceneCacheHandler::SceneCacheHandler(boost::filesystem::path const& _filepath, std::map<std::string, bool> const& _modes)
+            : FileHandler(_filepath, _modes)
+        {}
+        SceneCacheHandler::~SceneCacheHandler(void)
+        {}
+
+        SceneCache SceneCacheHandler::read(void)
+        {
+            std::ostringstream error_message;
+
+            if(!modes["read"])
+            {
+                error_message << std::boolalpha << "The read mode is set to:" << modes["read"] << "! You should set it as follows: \'modes[\"read\"] = true\'";
+                boost::system::error_code ec(boost::system::errc::io_error, boost::system::system_category());
+                throw boost::filesystem::filesystem_error(error_message.str(), ec);
+            }
+            if(!boost::filesystem::is_regular_file(filepath))
+            {
+                error_message << "This file: " << filepath.string() << " cannot be found! You should check the file path.";
+                boost::system::error_code ec(boost::system::errc::no_such_file_or_directory, boost::system::system_category());
+                throw boost::filesystem::filesystem_error(error_message.str(), ec);
+            }
+
+            return SceneCache(filepath);
+        }
+
+        void SceneCacheHandler::write(scene::Scene const& scene, bool const pruned, bool const terrain, SceneCacheSource const& source)
+        {
+            if(!modes["write"])
+            {
+                std::ostringstream error_message;
+                error_message << std::boolalpha << "The write mode is set to:" << modes["write"] << "! You should set it as follows: \'modes[\"write\"] = true\'";
+                boost::system::error_code ec(boost::system::errc::io_error, boost::system::system_category());
+                throw boost::filesystem::filesystem_error(error_message.str(), ec);
+            }
+
+            shadow::Point const pivot = scene.get_pivot();
+            SceneCacheHeader header{
+                {scene_cache_magic[0], scene_cache_magic[1], scene_cache_magic[2], scene_cache_magic[3]},
+                version,
+                scene.get_epsg(),
+                checked_size(scene.size(), "buildings"),
+                (pruned ? 1u : 0u) | (pruned && terrain ? 2u : 0u),
+                0,
+                {pivot.x(), pivot.y(), pivot.z()},
+                source
+            };
+
+            std::ofstream cache_file(filepath.string(), std::ios::out | std::ios::binary);
+            cache_file.exceptions(std::ios::failbit | std::ios::badbit);
+            cache_file.write(reinterpret_cast<char const*>(&header), sizeof(SceneCacheHeader));
+            for(auto const& building : scene)
+                write_node(cache_file, building, pruned);
+            write_node(cache_file, scene.get_terrain(), pruned && terrain);
+        }
+    }
+}
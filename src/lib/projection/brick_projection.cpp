@@ -21,7 +21,9 @@ namespace city
         BrickPrint::BrickPrint(FacePrint const& face_projection)
             : bounding_box(face_projection.bbox()),
               projected_facets(std::vector<FacePrint>{{face_projection}})
-        {}
+        {
+            index_facets();
+        }
         BrickPrint::BrickPrint(OGRLayer* projection_layer)
         {
             projection_layer->ResetReading();
@@ -34,15 +36,24 @@ namespace city
                 OGRFeature::DestroyFeature(ogr_facet);
                 bounding_box += facet.bbox();
             }
+            index_facets();
         }
         BrickPrint::BrickPrint(BrickPrint const& other)
             : bounding_box(other.bounding_box),
-              projected_facets(other.projected_facets)
+              projected_facets(other.projected_facets),
+              facet_index(other.facet_index),
+              union_cache(other.union_cache),
+              union_cached(other.union_cached)
         {}
         BrickPrint::BrickPrint(BrickPrint && other)
             : bounding_box(std::move(other.bounding_box)),
-              projected_facets(std::move(other.projected_facets))
-        {}
+              projected_facets(std::move(other.projected_facets)),
+              facet_index(std::move(other.facet_index)),
+              union_cache(std::move(other.union_cache)),
+              union_cached(other.union_cached)
+        {
+            other.union_cached = false;
+        }
         BrickPrint::~BrickPrint(void)
         {}
 
@@ -52,12 +63,18 @@ namespace city
 
             swap(bounding_box, other.bounding_box);
             swap(projected_facets, other.projected_facets);
+            swap(facet_index, other.facet_index);
+            swap(union_cache, other.union_cache);
+            swap(union_cached, other.union_cached);
         }
             
         BrickPrint & BrickPrint::operator =(BrickPrint const& other)
         {
             bounding_box = other.bounding_box;
             projected_facets = other.projected_facets;
+            facet_index = other.facet_index;
+            union_cache = other.union_cache;
+            union_cached = other.union_cached;
 
             return *this;
         }
@@ -66,6 +83,10 @@ namespace city
         {
             bounding_box = std::move(other.bounding_box);
             projected_facets = std::move(other.projected_facets);
+            facet_index = std::move(other.facet_index);
+            union_cache = std::move(other.union_cache);
+            union_cached = other.union_cached;
+            other.union_cached = false;
 
             return *this;
         }
@@ -111,12 +132,13 @@ namespace city
 
         bool BrickPrint::contains(Point_2 const& point) const
         {
+            auto indexes = candidates(point.bbox());
             return std::any_of(
-                std::begin(projected_facets),
-                std::end(projected_facets),
-                [&point](FacePrint const& facet)
+                std::begin(indexes),
+                std::end(indexes),
+                [&point, this](std::size_t const index)
                 {
-                    return facet.contains(point);
+                    return projected_facets[index].contains(point);
                 }
             );
         }
@@ -131,9 +153,7 @@ namespace city
         }
         bool BrickPrint::contains(FacePrint const& facet) const
         {
-            Polygon_set ps;
-            for(auto const& _facet : projected_facets)
-                ps.join(_facet.get_polygon());
+            Polygon_set ps = candidate_union(facet.bbox());
             ps.intersection(facet.get_polygon());
             std::vector<Polygon_with_holes> _inter;
             ps.polygons_with_holes(std::back_inserter(_inter));
@@ -141,17 +161,13 @@ namespace city
         }
         bool BrickPrint::overlaps(Polygon const& polygon) const
         {
-            Polygon_set ps;
-            for(auto const& _facet : projected_facets)
-                ps.join(_facet.get_polygon());
+            Polygon_set ps = candidate_union(polygon.bbox());
             ps.intersection(polygon);
             return !ps.is_empty();
         }
         bool BrickPrint::overlaps(Polygon_with_holes const& polygon) const
         {
-            Polygon_set ps;
-            for(auto const& _facet : projected_facets)
-                ps.join(_facet.get_polygon());
+            Polygon_set ps = candidate_union(polygon.bbox());
             ps.intersection(polygon);
             return !ps.is_empty();
         }
@@ -183,15 +199,18 @@ namespace city
         {
             double height(0.);
             if(contains(point))
+            {
+                auto indexes = candidates(point.bbox());
                 height  = std::accumulate(
-                    std::begin(projected_facets),
-                    std::end(projected_facets),
+                    std::begin(indexes),
+                    std::end(indexes),
                     height,
-                    [&point](double & result_height, FacePrint const& facet)
+                    [&point, this](double & result_height, std::size_t const index)
                     {
-                        return result_height + facet.get_height(point);
+                        return result_height + projected_facets[index].get_height(point);
                     }
                 );
+            }
             return height;
         }
         double BrickPrint::get_height(InexactPoint_2 const& inexact_point) const
@@ -237,12 +256,8 @@ namespace city
         }
         std::vector<double> BrickPrint::edge_lengths(void) const
         {
-            Polygon_set ps;
-            for(auto const& _facet : projected_facets)
-                ps.join(_facet.get_polygon());
-            
             std::list<Polygon_with_holes> footprint_polygons;
-            ps.polygons_with_holes(std::back_inserter(footprint_polygons));
+            facets_union().polygons_with_holes(std::back_inserter(footprint_polygons));
 
             auto size = std::accumulate(
                 std::begin(footprint_polygons),
@@ -275,8 +290,21 @@ namespace city
             );
         }
 
+        Polygon_set const& BrickPrint::facets_union(void) const
+        {
+            if(!union_cached)
+            {
+                union_cache.clear();
+                for(auto const& facet : projected_facets)
+                    union_cache.join(facet.get_polygon());
+                union_cached = true;
+            }
+            return union_cache;
+        }
+
         void BrickPrint::filter(void)
         {
+            auto size = projected_facets.size();
             projected_facets.erase(
                 std::remove_if(
                     std::begin(projected_facets),
@@ -288,32 +316,55 @@ namespace city
                 ),
                 std::end(projected_facets)
             );
+            /* Empty and degenerate facets have no area: the union is left as it is */
+            if(projected_facets.size() != size)
+                index_facets();
         }
 
         BrickPrint & BrickPrint::operator +=(FacePrint const& lfacet)
         {
             if(projected_facets.empty())
-                projected_facets.push_back(lfacet);
+                push_facet(lfacet);
             else
             {
                 /* If lfacet does not intersect the surface we push it directly*/
                 if(!overlaps(lfacet))
-                    projected_facets.push_back(lfacet);
+                    push_facet(lfacet);
                 else
                 {
                     /* If lfacet is under the surface we loose it*/
                     if(!is_under(lfacet))
                     {
+                        std::vector<bool> touched(projected_facets.size(), false);
+                        for(auto const index : candidates(lfacet.bbox()))
+                            touched[index] = true;
+
                         std::vector<FacePrint> result;
                         BrickPrint lfacets(lfacet);
 
-                        for(auto const& rfacet : projected_facets)
+                        for(std::size_t index(0); index != projected_facets.size(); ++index)
                         {
-                            auto temp = lfacets.occlusion(rfacet);
-                            result.insert(std::end(result), std::begin(temp), std::end(temp));
+                            if(touched[index])
+                            {
+                                auto temp = lfacets.occlusion(projected_facets[index]);
+                                result.insert(std::end(result), std::begin(temp), std::end(temp));
+                            }
+                            else
+                            {
+                                /*
+                                * Disjoint bounding boxes: occlusion() would find no intersection
+                                * and hand the facet back once per remaining piece of lfacet.
+                                */
+                                lfacets.filter();
+                                result.insert(std::end(result), lfacets.size(), projected_facets[index]);
+                            }
                         }
                         result.insert(std::end(result), std::begin(lfacets.projected_facets), std::end(lfacets.projected_facets));
                         projected_facets = std::move(result);
+                        index_facets();
+                        /* Occlusion only splits the covered area between the facets: the union just grows by lfacet */
+                        if(union_cached)
+                            union_cache.join(lfacet.get_polygon());
                     }
                 }
             }
@@ -321,6 +372,17 @@ namespace city
 
             return *this;
         }
+        BrickPrint & BrickPrint::operator +=(FacePrint && lfacet)
+        {
+            /* Only facets pushed as they are can be moved, occluded ones are cut in new facets */
+            if(!projected_facets.empty() && overlaps(lfacet))
+                return operator +=(static_cast<FacePrint const&>(lfacet));
+
+            bounding_box += lfacet.bbox();
+            push_facet(std::move(lfacet));
+
+            return *this;
+        }
         BrickPrint & BrickPrint::operator +=(BrickPrint const& other)
         {
             filter();
@@ -335,6 +397,27 @@ namespace city
 
             return *this;
         }
+        BrickPrint & BrickPrint::operator +=(BrickPrint && other)
+        {
+            filter();
+            other.filter();
+
+            if(projected_facets.empty())
+            {
+                Bbox_2 box(bounding_box);
+                *this = std::move(other);
+                bounding_box += box;
+            }
+            else
+            {
+                for(auto & facet : other.projected_facets)
+                    operator +=(std::move(facet));
+                filter();
+            }
+            other = BrickPrint();
+
+            return *this;
+        }
 
         std::vector<FacePrint> BrickPrint::occlusion(FacePrint const& lfacet)
         {
@@ -372,6 +455,8 @@ namespace city
                 }
             }
             projected_facets = rhs;
+            union_cached = false;
+            index_facets();
 
             return lhs;
         }
@@ -408,6 +493,65 @@ namespace city
             }
         }
 
+        BrickPrint::Index_box BrickPrint::index_box(Bbox_2 const& box)
+        {
+            return Index_box(Index_point(box.xmin(), box.ymin()), Index_point(box.xmax(), box.ymax()));
+        }
+        void BrickPrint::index_facets(void)
+        {
+            std::vector<Index_value> values(projected_facets.size());
+            for(std::size_t index(0); index != projected_facets.size(); ++index)
+                values[index] = std::make_pair(index_box(projected_facets[index].bbox()), index);
+
+            facet_index = Facet_index(std::begin(values), std::end(values));
+        }
+        void BrickPrint::push_facet(FacePrint const& facet)
+        {
+            facet_index.insert(std::make_pair(index_box(facet.bbox()), projected_facets.size()));
+            projected_facets.push_back(facet);
+            if(union_cached)
+                union_cache.join(facet.get_polygon());
+        }
+        void BrickPrint::push_facet(FacePrint && facet)
+        {
+            facet_index.insert(std::make_pair(index_box(facet.bbox()), projected_facets.size()));
+            projected_facets.push_back(std::move(facet));
+            if(union_cached)
+                union_cache.join(projected_facets.back().get_polygon());
+        }
+        std::vector<std::size_t> BrickPrint::candidates(Bbox_2 const& box) const
+        {
+            std::vector<Index_value> hits;
+            facet_index.query(boost::geometry::index::intersects(index_box(box)), std::back_inserter(hits));
+
+            std::vector<std::size_t> indexes(hits.size());
+            std::transform(
+                std::begin(hits),
+                std::end(hits),
+                std::begin(indexes),
+                [](Index_value const& hit)
+                {
+                    return hit.second;
+                }
+            );
+            std::sort(std::begin(indexes), std::end(indexes));
+            return indexes;
+        }
+        Polygon_set BrickPrint::candidate_union(Bbox_2 const& box) const
+        {
+            auto indexes = candidates(box);
+            if(indexes.empty())
+                return Polygon_set();
+            /* Once built, the union is kept up to date and agrees with the candidates union inside the box */
+            if(union_cached || indexes.size() == projected_facets.size())
+                return facets_union();
+
+            Polygon_set ps;
+            for(auto const index : indexes)
+                ps.join(projected_facets[index].get_polygon());
+            return ps;
+        }
+
         bool BrickPrint::equal_facets(BrickPrint const& other) const
         {
             bool equality(projected_facets.size() == other.projected_facets.size());
@@ -3,6 +3,7 @@
 #include <projection/raster_projection.h>
 #include <projection/utilities.h>
 #include <algorithms/util_algorithms.h>
+#include <algorithms/raster_algorithms.h>
 
 #include <ogr_feature.h>
 #include <ogr_geometry.h>
@@ -11,6 +12,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <array>
 
 #include <cmath>
 #include <limits>
@@ -290,48 +292,81 @@ namespace city
             return feature;
         }
 
-        std::vector<double> & FacePrint::rasterize(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const height, std::size_t const width, double const pixel_size) const
+        std::vector<double> & FacePrint::rasterize(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const height, std::size_t const width, double const pixel_size, Rasterization const mode) const
+        {
+            return rasterize(image, hits, top_left, height, width, pixel_size, mode, PixelWindow{0, height, 0, width});
+        }
+        std::vector<double> & FacePrint::rasterize(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const height, std::size_t const width, double const pixel_size, Rasterization const mode, PixelWindow const& window) const
         {
             if(!is_degenerate())
             {
-                Bbox_2 bb = bbox();
-                std::size_t  i_min = static_cast<std::size_t>(std::floor((top_left.y() - bb.ymax()) / pixel_size)),
-                             j_min = static_cast<std::size_t>(std::floor((bb.xmin() - top_left.x()) / pixel_size));
-                std::size_t  w = static_cast<std::size_t>(std::ceil((bb.xmax() - bb.xmin()) / pixel_size)),
-                             h = static_cast<std::size_t>(std::ceil((bb.ymax() - bb.ymin()) / pixel_size));
-                if(i_min + h > height && j_min + w > width)
-                {
-                    std::stringstream error_message("Face out of bounds: ");
-                    error_message << i_min + h << " > " << height << " or " << j_min + w << " > " << width;
-                    throw std::runtime_error(error_message.str());
-                }
-
-                std::vector<std::size_t> indexes(w * h);
-                std::iota(std::begin(indexes), std::end(indexes), 0);
-                for(auto const& index : indexes)
+                PixelWindow clipped{window.row_begin, std::min(window.row_end, height), window.column_begin, std::min(window.column_end, width)};
+                switch(mode)
                 {
-                    bool hit = false;
-                    double z = get_height(
-                        bb.xmin() + static_cast<double>(index%w) * pixel_size,
-                        bb.ymax() - static_cast<double>(index/w) * pixel_size,
-                        pixel_size,
-                        hit
-                    );
-                    if(hit)
-                        image.at((i_min + index/w) * width + j_min + index%w)
-                        =   (
-                                image.at((i_min + index/w) * width + j_min + index%w) * static_cast<double>(hits.at((i_min + index/w) * width + j_min + index%w))
-                                +
-                                z
-                            )
-                            /
-                            static_cast<double>(++hits.at((i_min + index/w) * width + j_min + index%w));
+                    case Rasterization::exact:
+                        rasterize_exact(image, hits, top_left, height, width, pixel_size, clipped);
+                        break;
+                    case Rasterization::scanline:
+                        rasterize_scanline(image, hits, top_left, width, pixel_size, clipped);
+                        break;
                 }
             }
             
             return image;
         }
 
+        void FacePrint::rasterize_exact(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const height, std::size_t const width, double const pixel_size, PixelWindow const& window) const
+        {
+            Bbox_2 bb = bbox();
+            std::size_t  i_min = static_cast<std::size_t>(std::floor((top_left.y() - bb.ymax()) / pixel_size)),
+                         j_min = static_cast<std::size_t>(std::floor((bb.xmin() - top_left.x()) / pixel_size));
+            std::size_t  w = static_cast<std::size_t>(std::ceil((bb.xmax() - bb.xmin()) / pixel_size)),
+                         h = static_cast<std::size_t>(std::ceil((bb.ymax() - bb.ymin()) / pixel_size));
+            if(i_min + h > height && j_min + w > width)
+            {
+                std::stringstream error_message("Face out of bounds: ");
+                error_message << i_min + h << " > " << height << " or " << j_min + w << " > " << width;
+                throw std::runtime_error(error_message.str());
+            }
+
+            std::vector<std::size_t> indexes(w * h);
+            std::iota(std::begin(indexes), std::end(indexes), 0);
+            for(auto const& index : indexes)
+            {
+                if(i_min + index/w < window.row_begin || i_min + index/w >= window.row_end || j_min + index%w < window.column_begin || j_min + index%w >= window.column_end)
+                    continue;
+
+                bool hit = false;
+                double z = get_height(
+                    bb.xmin() + static_cast<double>(index%w) * pixel_size,
+                    bb.ymax() - static_cast<double>(index/w) * pixel_size,
+                    pixel_size,
+                    hit
+                );
+                if(hit)
+                    image.at((i_min + index/w) * width + j_min + index%w)
+                    =   (
+                            image.at((i_min + index/w) * width + j_min + index%w) * static_cast<double>(hits.at((i_min + index/w) * width + j_min + index%w))
+                            +
+                            z
+                        )
+                        /
+                        static_cast<double>(++hits.at((i_min + index/w) * width + j_min + index%w));
+            }
+        }
+
+        void FacePrint::rasterize_scanline(std::vector<double> & image, std::vector<short> & hits, shadow::Point const& top_left, std::size_t const width, double const pixel_size, PixelWindow const& window) const
+        {
+            ScanlinePrint(*this).rasterize(
+                image.data() + window.row_begin * width + window.column_begin,
+                hits.data() + window.row_begin * width + window.column_begin,
+                width,
+                top_left,
+                pixel_size,
+                window
+            );
+        }
+
         std::ostream & operator <<(std::ostream & os, FacePrint const& facet)
         {
             return os << "Id: " << facet.id << std::endl
@@ -348,6 +383,80 @@ namespace city
         {
             return !(lhs == rhs);
         }
+
+        ScanlinePrint::ScanlinePrint(FacePrint const& facet)
+            : box(facet.bbox())
+        {
+            ExactToInexact to_inexact;
+            Plane_3 const& plane = facet.get_plane();
+            double c = to_inexact(plane.c());
+            alpha = - to_inexact(plane.d()) / c;
+            beta = - to_inexact(plane.a()) / c;
+            gamma = - to_inexact(plane.b()) / c;
+
+            auto push_edges = [this, &to_inexact](Polygon const& polygon)
+            {
+                std::for_each(
+                    polygon.edges_begin(),
+                    polygon.edges_end(),
+                    [this, &to_inexact](Segment_2 const& edge)
+                    {
+                        InexactPoint_2 source = to_inexact(edge.source()),
+                                       target = to_inexact(edge.target());
+                        if(source.y() < target.y())
+                            edges.push_back(Edge{{source.x(), source.y(), target.x(), target.y()}});
+                        else if(target.y() < source.y())
+                            edges.push_back(Edge{{target.x(), target.y(), source.x(), source.y()}});
+                    }
+                );
+            };
+            push_edges(facet.outer_boundary());
+            std::for_each(facet.holes_begin(), facet.holes_end(), push_edges);
+        }
+
+        Bbox_2 const& ScanlinePrint::bbox(void) const noexcept
+        {
+            return box;
+        }
+
+        void ScanlinePrint::rasterize(double* image, short* hits, std::size_t const stride, shadow::Point const& top_left, double const pixel_size, PixelWindow const& window) const
+        {
+            std::size_t row_begin = std::max(window.row_begin, static_cast<std::size_t>(std::max(0., std::floor((top_left.y() - box.ymax()) / pixel_size)))),
+                        row_end = std::min(window.row_end, static_cast<std::size_t>(std::max(0., std::ceil((top_left.y() - box.ymin()) / pixel_size))));
+
+            std::vector<double> crossings;
+            crossings.reserve(edges.size());
+            for(std::size_t row = row_begin; row < row_end; ++row)
+            {
+                double y = top_left.y() - (static_cast<double>(row) + .5) * pixel_size;
+
+                /* Half open edges so that shared vertices are crossed once */
+                crossings.clear();
+                for(auto const& edge : edges)
+                    if(edge[1] <= y && y < edge[3])
+                        crossings.push_back(edge[0] + (y - edge[1]) * (edge[2] - edge[0]) / (edge[3] - edge[1]));
+                std::sort(std::begin(crossings), std::end(crossings));
+
+                /* Heights are stepped from column 0, so that they do not depend on the window */
+                double row_origin = alpha + beta * (top_left.x() + .5 * pixel_size) + gamma * y;
+
+                /* Even-odd spans: pixel centers in [x_in, x_out) are inside the facet */
+                for(std::size_t span = 0; span + 1 < crossings.size(); span += 2)
+                {
+                    double first = std::max(static_cast<double>(window.column_begin), std::ceil((crossings[span] - top_left.x()) / pixel_size - .5)),
+                           last = std::min(static_cast<double>(window.column_end), std::ceil((crossings[span + 1] - top_left.x()) / pixel_size - .5));
+                    if(first < last)
+                        accumulate_plane_row(
+                            image + (row - window.row_begin) * stride + static_cast<std::size_t>(first) - window.column_begin,
+                            hits + (row - window.row_begin) * stride + static_cast<std::size_t>(first) - window.column_begin,
+                            static_cast<std::size_t>(last - first),
+                            row_origin,
+                            beta * pixel_size,
+                            static_cast<std::size_t>(first)
+                        );
+                }
+            }
+        }
     }
 
     void swap(projection::FacePrint & lhs, projection::FacePrint & rhs)
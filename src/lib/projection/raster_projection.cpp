@@ -1,6 +1,7 @@
 #include <projection/raster_projection.h>
 
 #include <shadow/vector.h>
+#include <algorithms/parallel_algorithms.h>
 
 #include <cpl_string.h>
 
@@ -14,9 +15,119 @@ namespace city
 {
     namespace projection
     {
+        namespace
+        {
+            std::vector<ScanlinePrint> scanlines(FootPrint const& footprint)
+            {
+                std::vector<ScanlinePrint> facets;
+                for(auto const& facet : footprint)
+                    if(!facet.is_degenerate())
+                        facets.push_back(ScanlinePrint(facet));
+                return facets;
+            }
+
+            template<typename Facet>
+            std::vector<Bbox_2> boxes(std::vector<Facet> const& facets)
+            {
+                std::vector<Bbox_2> facet_boxes(facets.size());
+                std::transform(
+                    std::begin(facets),
+                    std::end(facets),
+                    std::begin(facet_boxes),
+                    [](Facet const& facet)
+                    {
+                        return facet.bbox();
+                    }
+                );
+                return facet_boxes;
+            }
+
+            void geotransform_to_gdal(GDALDataset* file, shadow::Point const& reference_point, double const pixel_size)
+            {
+                double adfGeoTransform[6] = {reference_point.x(), pixel_size, 0, reference_point.y(), 0, - pixel_size};
+                file->SetGeoTransform(adfGeoTransform);
+            }
+            void projection_to_gdal(GDALDataset* file, unsigned short const epsg_index)
+            {
+                OGRSpatialReference spatial_reference_system;
+                char* spatial_reference_system_name = nullptr;
+                spatial_reference_system.importFromEPSG(epsg_index);
+                spatial_reference_system.exportToWkt(&spatial_reference_system_name);
+                file->SetProjection(spatial_reference_system_name);
+                CPLFree(spatial_reference_system_name);
+            }
+        }
+
+        SampleFormat::SampleFormat(SampleType const _type, double const _scale, double const _offset)
+            : type(_type), scale(_scale), offset(_offset)
+        {}
+        GDALDataType SampleFormat::gdal_type(void) const
+        {
+            switch(type)
+            {
+                case SampleType::float32:
+                    return GDT_Float32;
+                case SampleType::int16:
+                    return GDT_Int16;
+                case SampleType::int32:
+                    return GDT_Int32;
+                default:
+                    return GDT_Float64;
+            }
+        }
+        void SampleFormat::encode(std::vector<double> & heights) const
+        {
+            bool integer = type == SampleType::int16 || type == SampleType::int32;
+            std::transform(
+                std::begin(heights),
+                std::end(heights),
+                std::begin(heights),
+                [this, integer](double const height)
+                {
+                    return integer ? std::round((height - offset) / scale) : (height - offset) / scale;
+                }
+            );
+        }
+        void SampleFormat::decode(std::vector<double> & samples) const
+        {
+            std::transform(
+                std::begin(samples),
+                std::end(samples),
+                std::begin(samples),
+                [this](double const sample)
+                {
+                    return sample * scale + offset;
+                }
+            );
+        }
+        void SampleFormat::to_gdal(GDALRasterBand* band) const
+        {
+            band->SetScale(scale);
+            band->SetOffset(offset);
+        }
+        SampleFormat SampleFormat::from_gdal(GDALRasterBand* band)
+        {
+            SampleFormat format(SampleType::float64, band->GetScale(), band->GetOffset());
+            switch(band->GetRasterDataType())
+            {
+                case GDT_Float32:
+                    format.type = SampleType::float32;
+                    break;
+                case GDT_Int16:
+                    format.type = SampleType::int16;
+                    break;
+                case GDT_Int32:
+                    format.type = SampleType::int32;
+                    break;
+                default:
+                    break;
+            }
+            return format;
+        }
+
         RasterPrint::RasterPrint(void)
         {}
-        RasterPrint::RasterPrint(FootPrint const& footprint, double const _pixel_size)
+        RasterPrint::RasterPrint(FootPrint const& footprint, double const _pixel_size, Rasterization const mode, std::size_t const workers)
             : name(footprint.get_name()),
               reference_point(footprint.get_reference_point() + shadow::Vector(footprint.bbox().xmin(), footprint.bbox().ymax(), 0)),
               epsg_index(footprint.get_epsg()),
@@ -26,15 +137,38 @@ namespace city
               image_matrix(height * width, 0.),
               pixel_hits(height * width, 0)
         {
-            image_matrix = std::accumulate(
-                std::begin(footprint),
-                std::end(footprint),
-                image_matrix,
-                [this, &footprint](std::vector<double> & image, projection::FacePrint const& face_projection)
-                {
-                    return face_projection.rasterize(image, pixel_hits, shadow::Point(footprint.bbox().xmin(), footprint.bbox().ymax(), 0), height, width, pixel_size);
-                }
-            );
+            shadow::Point top_left(footprint.bbox().xmin(), footprint.bbox().ymax(), 0);
+            auto windows = tile(height, width, raster_tile_size, raster_tile_size);
+
+            if(mode == Rasterization::exact)
+            {
+                std::vector<FacePrint> facets(std::begin(footprint), std::end(footprint));
+                auto bins = bin(boxes(facets), top_left, pixel_size, height, width, raster_tile_size, raster_tile_size);
+                for(std::size_t tile = 0; tile != windows.size(); ++tile)
+                    for(auto const facet : bins[tile])
+                        facets[facet].rasterize(image_matrix, pixel_hits, top_left, height, width, pixel_size, mode, windows[tile]);
+            }
+            else
+            {
+                auto facets = scanlines(footprint);
+                auto bins = bin(boxes(facets), top_left, pixel_size, height, width, raster_tile_size, raster_tile_size);
+                parallel_for(
+                    windows.size(),
+                    [this, &windows, &bins, &facets, &top_left](std::size_t const tile)
+                    {
+                        for(auto const facet : bins[tile])
+                            facets[facet].rasterize(
+                                image_matrix.data() + windows[tile].row_begin * width + windows[tile].column_begin,
+                                pixel_hits.data() + windows[tile].row_begin * width + windows[tile].column_begin,
+                                width,
+                                top_left,
+                                pixel_size,
+                                windows[tile]
+                            );
+                    },
+                    workers
+                );
+            }
             vertical_offset();
         }
         RasterPrint::RasterPrint(std::string const& filename, GDALDataset* raster_file)
@@ -63,13 +197,15 @@ namespace city
             reference_point = shadow::Point(geographic_transform[0], geographic_transform[3], 0);
             pixel_size = geographic_transform[1];
             
-            double* buffer = reinterpret_cast<double*>(calloc(sizeof(double), width * height));
             GDALRasterBand* raster_band = raster_file->GetRasterBand(1);
-            CPLErr error = raster_band->RasterIO(GF_Read, 0, 0, static_cast<int>(width), static_cast<int>(height), buffer, static_cast<int>(width), static_cast<int>(height), GDT_Float64, 0, 0);
+            sample_format = SampleFormat::from_gdal(raster_band);
+
+            image_matrix = std::vector<double>(width * height, 0.);
+            CPLErr error = raster_band->RasterIO(GF_Read, 0, 0, static_cast<int>(width), static_cast<int>(height), image_matrix.data(), static_cast<int>(width), static_cast<int>(height), GDT_Float64, 0, 0);
             if(error != CE_None)
                 throw std::runtime_error("GDAL could not read raster band");
 
-            image_matrix = std::vector<double>(buffer, buffer + width * height);
+            sample_format.decode(image_matrix);
         }
         RasterPrint::RasterPrint(RasterPrint const& other)
             : name(other.name),
@@ -80,7 +216,8 @@ namespace city
               pixel_size(other.pixel_size),
               image_matrix(other.image_matrix),
               pixel_hits(other.pixel_hits),
-              offset(other.offset)
+              offset(other.offset),
+              sample_format(other.sample_format)
         {}
         RasterPrint::RasterPrint(RasterPrint && other)
             : name(std::move(other.name)),
@@ -91,7 +228,8 @@ namespace city
               pixel_size(std::move(other.pixel_size)),
               image_matrix(std::move(other.image_matrix)),
               pixel_hits(std::move(other.pixel_hits)),
-              offset(std::move(other.offset))
+              offset(std::move(other.offset)),
+              sample_format(std::move(other.sample_format))
         {}
         RasterPrint::~RasterPrint(void)
         {}
@@ -129,6 +267,14 @@ namespace city
         {
             return pixel_size;
         }
+        SampleFormat const& RasterPrint::get_sample_format(void) const noexcept
+        {
+            return sample_format;
+        }
+        void RasterPrint::set_sample_format(SampleFormat const& format) noexcept
+        {
+            sample_format = format;
+        }
 
         double* RasterPrint::data(void) noexcept
         {
@@ -152,6 +298,7 @@ namespace city
             swap(image_matrix, other.image_matrix);
             swap(pixel_hits, other.pixel_hits);
             swap(offset, other.offset);
+            swap(sample_format, other.sample_format);
         }
 
         double & RasterPrint::at(std::size_t const& i, std::size_t const& j)
@@ -215,6 +362,7 @@ namespace city
             image_matrix = other.image_matrix;
             pixel_hits = other.pixel_hits;
             offset = other.offset;
+            sample_format = other.sample_format;
 
             return *this;
         }
@@ -230,6 +378,7 @@ namespace city
             image_matrix = std::move(other.image_matrix);
             pixel_hits = std::move(other.pixel_hits);
             offset = std::move(other.offset);
+            sample_format = std::move(other.sample_format);
             
             return *this;
         }
@@ -247,30 +396,28 @@ namespace city
 
         void RasterPrint::set_geotransform(GDALDataset* file) const
         {
-            double adfGeoTransform[6] = {reference_point.x(), pixel_size, 0, reference_point.y(), 0, - pixel_size};
-            file->SetGeoTransform(adfGeoTransform);
+            geotransform_to_gdal(file, reference_point, pixel_size);
         }
 
         void RasterPrint::set_projection(GDALDataset* file) const
         {
-            OGRSpatialReference spatial_reference_system;
-            char* spatial_reference_system_name = nullptr;
-            spatial_reference_system.importFromEPSG(epsg_index);
-            spatial_reference_system.exportToWkt(&spatial_reference_system_name);
-            file->SetProjection(spatial_reference_system_name);
-            CPLFree(spatial_reference_system_name);
+            projection_to_gdal(file, epsg_index);
         }
         
         void RasterPrint::save_image(GDALDataset* file) const
         {
             GDALRasterBand* unique_band = file->GetRasterBand(1);
+            sample_format.to_gdal(unique_band);
+
+            std::vector<double> samples(image_matrix);
+            sample_format.encode(samples);
             CPLErr error = unique_band->RasterIO(
                 GF_Write,
                 0,
                 0,
                 static_cast<int>(width),
                 static_cast<int>(height),
-                const_cast<double*>(image_matrix.data()),
+                samples.data(),
                 static_cast<int>(width),
                 static_cast<int>(height),
                 GDT_Float64,
@@ -357,6 +504,96 @@ namespace city
         {
             return !(lhs == rhs);
         }
+
+        std::vector<PixelWindow> tile(std::size_t const height, std::size_t const width, std::size_t const tile_height, std::size_t const tile_width)
+        {
+            std::vector<PixelWindow> windows;
+            for(std::size_t row = 0; row < height; row += tile_height)
+                for(std::size_t column = 0; column < width; column += tile_width)
+                    windows.push_back(PixelWindow{row, std::min(row + tile_height, height), column, std::min(column + tile_width, width)});
+            return windows;
+        }
+
+        std::vector< std::vector<std::size_t> > bin(std::vector<Bbox_2> const& boxes, shadow::Point const& top_left, double const pixel_size, std::size_t const height, std::size_t const width, std::size_t const tile_height, std::size_t const tile_width)
+        {
+            std::size_t tile_columns = (width + tile_width - 1) / tile_width;
+            std::vector< std::vector<std::size_t> > bins(((height + tile_height - 1) / tile_height) * tile_columns);
+            for(std::size_t index = 0; index != boxes.size(); ++index)
+            {
+                Bbox_2 const& bb = boxes[index];
+                double row_first = std::max(0., std::floor((top_left.y() - bb.ymax()) / pixel_size) - 1),
+                       row_last = std::min(static_cast<double>(height), std::ceil((top_left.y() - bb.ymin()) / pixel_size) + 1),
+                       column_first = std::max(0., std::floor((bb.xmin() - top_left.x()) / pixel_size) - 1),
+                       column_last = std::min(static_cast<double>(width), std::ceil((bb.xmax() - top_left.x()) / pixel_size) + 1);
+                if(!(row_first < row_last && column_first < column_last))
+                    continue;
+
+                for(std::size_t tile_row = static_cast<std::size_t>(row_first) / tile_height; tile_row * tile_height < static_cast<std::size_t>(row_last); ++tile_row)
+                    for(std::size_t tile_column = static_cast<std::size_t>(column_first) / tile_width; tile_column * tile_width < static_cast<std::size_t>(column_last); ++tile_column)
+                        bins[tile_row * tile_columns + tile_column].push_back(index);
+            }
+            return bins;
+        }
+
+        void stream_raster(FootPrint const& footprint, double const pixel_size, GDALDataset* file, std::size_t const workers)
+        {
+            shadow::Point top_left(footprint.bbox().xmin(), footprint.bbox().ymax(), 0);
+            double const vertical_offset = footprint.get_reference_point().z();
+            geotransform_to_gdal(file, footprint.get_reference_point() + shadow::Vector(footprint.bbox().xmin(), footprint.bbox().ymax(), 0), pixel_size);
+            projection_to_gdal(file, footprint.get_epsg());
+
+            GDALRasterBand* band = file->GetRasterBand(1);
+            int block_width_buffer(0), block_height_buffer(0);
+            band->GetBlockSize(&block_width_buffer, &block_height_buffer);
+            SampleFormat format = SampleFormat::from_gdal(band);
+            int const sample_bytes = GDALGetDataTypeSize(format.gdal_type()) / 8;
+
+            std::size_t const height = static_cast<std::size_t>(file->GetRasterYSize()),
+                              width = static_cast<std::size_t>(file->GetRasterXSize()),
+                              block_height = static_cast<std::size_t>(block_height_buffer),
+                              block_width = static_cast<std::size_t>(block_width_buffer);
+
+            auto facets = scanlines(footprint);
+            auto windows = tile(height, width, block_height, block_width);
+            auto bins = bin(boxes(facets), top_left, pixel_size, height, width, block_height, block_width);
+
+            /* One block buffer per worker: blocks are filled concurrently, then written in order */
+            std::size_t const batch = resolve_workers(workers);
+            std::vector< std::vector<double> > images(std::min(batch, windows.size()), std::vector<double>(block_height * block_width));
+            std::vector< std::vector<short> > hits(images.size(), std::vector<short>(block_height * block_width));
+            std::vector< std::vector<unsigned char> > blocks(images.size(), std::vector<unsigned char>(block_height * block_width * static_cast<std::size_t>(sample_bytes)));
+            for(std::size_t first = 0; first < windows.size(); first += batch)
+            {
+                std::size_t const count = std::min(batch, windows.size() - first);
+                parallel_for(
+                    count,
+                    [&images, &hits, &blocks, &facets, &windows, &bins, &top_left, &format, first, block_width, pixel_size, vertical_offset, sample_bytes](std::size_t const slot)
+                    {
+                        std::fill(std::begin(images[slot]), std::end(images[slot]), 0.);
+                        std::fill(std::begin(hits[slot]), std::end(hits[slot]), 0);
+                        for(auto const facet : bins[first + slot])
+                            facets[facet].rasterize(images[slot].data(), hits[slot].data(), block_width, top_left, pixel_size, windows[first + slot]);
+                        for(std::size_t index = 0; index != images[slot].size(); ++index)
+                            images[slot][index] += (hits[slot][index] != 0) * vertical_offset;
+
+                        format.encode(images[slot]);
+                        GDALCopyWords(images[slot].data(), GDT_Float64, sizeof(double), blocks[slot].data(), format.gdal_type(), sample_bytes, static_cast<int>(images[slot].size()));
+                    },
+                    workers
+                );
+                for(std::size_t slot = 0; slot != count; ++slot)
+                {
+                    PixelWindow const& window = windows[first + slot];
+                    CPLErr error = band->WriteBlock(
+                        static_cast<int>(window.column_begin / block_width),
+                        static_cast<int>(window.row_begin / block_height),
+                        blocks[slot].data()
+                    );
+                    if(error != CE_None)
+                        throw std::runtime_error("GDAL could not write raster block");
+                }
+            }
+        }
     }
 
     void swap(projection::RasterPrint & lhs, projection::RasterPrint & rhs)
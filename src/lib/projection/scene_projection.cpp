@@ -145,6 +145,19 @@ namespace city
             }
             return *this;
         }
+        FootPrint & FootPrint::operator +=(FootPrint && other)
+        {
+            if(projection.is_empty())
+                *this = std::move(other);
+            else
+            {
+                if(reference_point != other.reference_point || epsg_index != other.epsg_index)
+                    throw std::logic_error("Feature not supported");
+                
+                projection += std::move(other.projection);
+            }
+            return *this;
+        }
 
         void FootPrint::to_ogr(GDALDataset* file, bool labels) const
         {
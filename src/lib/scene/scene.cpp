@@ -2,11 +2,14 @@
 
 #include <algorithms/util_algorithms.h>
 #include <algorithms/unode_algorithms.h>
+#include <algorithms/parallel_algorithms.h>
 
 namespace city
 {
     namespace scene
     {
+        const double Scene::no_welding = -1.;
+
         Scene::Scene(void)
         {}
         Scene::Scene(
@@ -29,6 +32,41 @@ namespace city
 
             terrain = UNode(terrain_mesh, pivot, epsg_index);
         }
+        Scene::Scene(
+            std::vector<shadow::Mesh> && building_meshes,
+            shadow::Mesh && terrain_mesh,
+            city::shadow::Point const& _pivot,
+            unsigned short _epsg_index,
+            std::size_t const workers,
+            double const weld_tolerance
+        )
+            : pivot(_pivot), epsg_index(_epsg_index), buildings(building_meshes.size())
+        {
+            /* The terrain, usually the largest mesh, is handed out first */
+            parallel_for(
+                building_meshes.size() + 1,
+                [this, &building_meshes, &terrain_mesh, weld_tolerance](std::size_t const index)
+                {
+                    shadow::Mesh mesh(std::move(index == 0 ? terrain_mesh : building_meshes[index - 1]));
+                    if(weld_tolerance >= 0)
+                        mesh.weld(weld_tolerance);
+                    if(index == 0)
+                        terrain = UNode(mesh, pivot, epsg_index);
+                    else
+                        buildings[index - 1] = UNode(mesh, pivot, epsg_index);
+                },
+                workers
+            );
+            building_meshes.clear();
+        }
+        Scene::Scene(
+            std::vector<UNode> && _buildings,
+            UNode && _terrain,
+            city::shadow::Point const& _pivot,
+            unsigned short _epsg_index
+        )
+            : pivot(_pivot), epsg_index(_epsg_index), buildings(std::move(_buildings)), terrain(std::move(_terrain))
+        {}
         Scene::Scene(Scene const& other)
             : pivot(other.pivot), epsg_index(other.epsg_index), buildings(other.buildings), terrain(other.terrain)
         {}
@@ -129,26 +167,27 @@ namespace city
             lhs.swap(rhs);
         }
 
-        Scene & Scene::prune(bool const _terrain)
+        Scene & Scene::prune(bool const _terrain, std::size_t const workers)
         {
-            std::transform(
-                std::begin(buildings),
-                std::end(buildings),
-                std::begin(buildings),
-                [](scene::UNode & building)
+            std::size_t const shift = _terrain ? 1 : 0;
+            parallel_for(
+                buildings.size() + shift,
+                [this, shift](std::size_t const index)
                 {
-                    return ::city::prune(building);
-                }
+                    if(index < shift)
+                        ::city::prune(terrain);
+                    else
+                        ::city::prune(buildings[index - shift]);
+                },
+                workers
             );
-            if(_terrain)
-                terrain = ::city::prune(terrain);
 
             return *this;
         }
     }
 
-    scene::Scene & prune(scene::Scene & scene, bool const terrain)
+    scene::Scene & prune(scene::Scene & scene, bool const terrain, std::size_t const workers)
     {
-        return scene.prune(terrain);
+        return scene.prune(terrain, workers);
     }
 }
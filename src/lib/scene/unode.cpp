@@ -9,6 +9,9 @@
 #include <CGAL/Polygon_mesh_processing/compute_normal.h>
 #include <CGAL/Polygon_mesh_processing/measure.h>
 
+#include <CGAL/Polyhedron_incremental_builder_3.h>
+#include <CGAL/Modifier_base.h>
+
 #include <CGAL/IO/Polyhedron_iostream.h>
 #include <CGAL/IO/Nef_polyhedron_iostream_3.h>
 
@@ -17,12 +20,75 @@
 #endif // CGAL_USE_GEOMVIEW
 
 #include <vector>
+#include <array>
+#include <set>
+#include <map>
+#include <unordered_set>
+#include <unordered_map>
+#include <stdexcept>
 
 
 namespace city
 {
     namespace scene
     {
+        namespace
+        {
+            /**
+             * Orients a polygon soup consistently and turns it into a surface.
+             * @param points soup points, duplicated where the soup is not manifold
+             * @param polygons soup polygons, reoriented consistently
+             * @param surface the surface to fill
+             */
+            void soup_to_surface(std::vector<Point_3> & points, std::vector< std::vector<std::size_t> > & polygons, Polyhedron & surface)
+            {
+                CGAL::Polygon_mesh_processing::orient_polygon_soup(points, polygons);
+                CGAL::Polygon_mesh_processing::polygon_soup_to_polygon_mesh(points, polygons, surface);
+            }
+
+            /**
+             * Fills a surface straight from the buffers of a flat mesh, with no intermediate soup.
+             * The facets must already be consistently oriented: on the first facet the incremental builder rejects,
+             * the surface is rolled back and left empty.
+             */
+            class FlatMeshBuilder: public CGAL::Modifier_base<Polyhedron::HalfedgeDS>
+            {
+            public:
+                explicit FlatMeshBuilder(shadow::FlatMesh const& _mesh)
+                    : mesh(_mesh), built(false)
+                {}
+
+                void operator()(Polyhedron::HalfedgeDS & hds)
+                {
+                    CGAL::Polyhedron_incremental_builder_3<Polyhedron::HalfedgeDS> builder(hds);
+                    builder.begin_surface(mesh.points_size(), mesh.faces_size(), mesh.indices_size());
+                    for(std::size_t point(0); point != mesh.points_size(); ++point)
+                        builder.add_vertex(Point_3(mesh.get_x()[point], mesh.get_y()[point], mesh.get_z()[point]));
+                    for(std::size_t face(0); face != mesh.faces_size(); ++face)
+                    {
+                        if(!builder.test_facet(mesh.face_cbegin(face), mesh.face_cend(face)))
+                        {
+                            builder.rollback();
+                            return;
+                        }
+                        builder.add_facet(mesh.face_cbegin(face), mesh.face_cend(face));
+                    }
+                    builder.end_surface();
+                    built = !builder.error();
+                    if(!built)
+                        builder.rollback();
+                }
+
+                bool is_built(void) const noexcept
+                {
+                    return built;
+                }
+            private:
+                shadow::FlatMesh const& mesh;
+                bool built;
+            };
+        }
+
         UNode::UNode(void) 
         {}
         UNode::UNode(UNode const& other)
@@ -100,8 +166,29 @@ namespace city
             std::vector<Point_3> points = mesh.get_cgal_points();
             std::vector< std::vector<std::size_t> > polygons = mesh.get_cgal_faces();
 
-            CGAL::Polygon_mesh_processing::orient_polygon_soup(points, polygons);
-            CGAL::Polygon_mesh_processing::polygon_soup_to_polygon_mesh(points, polygons, surface);
+            soup_to_surface(points, polygons, surface);
+            if(CGAL::is_closed(surface) && !CGAL::Polygon_mesh_processing::is_outward_oriented(surface))
+                CGAL::Polygon_mesh_processing::reverse_face_orientations(surface);
+            if(!surface.empty())
+                bounding_box = CGAL::Polygon_mesh_processing::bbox(surface);
+        }
+        UNode::UNode(
+            shadow::FlatMesh const& mesh,
+            shadow::Point const& _reference_point,
+            unsigned short const _epsg_index
+        )
+            : name(mesh.get_name()), reference_point(_reference_point), epsg_index(_epsg_index)
+        {
+            FlatMeshBuilder builder(mesh);
+            surface.delegate(builder);
+            /* Soups that are not consistently oriented are reoriented as in the Mesh constructor */
+            if(!builder.is_built())
+            {
+                surface.clear();
+                std::vector<Point_3> points = mesh.get_cgal_points();
+                std::vector< std::vector<std::size_t> > polygons = mesh.get_cgal_faces();
+                soup_to_surface(points, polygons, surface);
+            }
             if(CGAL::is_closed(surface) && !CGAL::Polygon_mesh_processing::is_outward_oriented(surface))
                 CGAL::Polygon_mesh_processing::reverse_face_orientations(surface);
             if(!surface.empty())
@@ -116,13 +203,34 @@ namespace city
         )
             :name(building_id), reference_point(_reference_point), epsg_index(_epsg_index)
         {
-            CGAL::Polygon_mesh_processing::orient_polygon_soup(points, polygons);
-            CGAL::Polygon_mesh_processing::polygon_soup_to_polygon_mesh(points, polygons, surface);
+            soup_to_surface(points, polygons, surface);
             if (CGAL::is_closed(surface) && !CGAL::Polygon_mesh_processing::is_outward_oriented(surface))
                 CGAL::Polygon_mesh_processing::reverse_face_orientations(surface);
             if(!surface.empty())
                 bounding_box = CGAL::Polygon_mesh_processing::bbox(surface);
         }
+        UNode::UNode(
+            std::string const& building_id,
+            std::vector<Point_3> const& points,
+            std::vector< std::vector<std::size_t> > const& polygons,
+            std::vector<std::size_t> const& facet_ids,
+            shadow::Point const& _reference_point,
+            unsigned short const _epsg_index
+        )
+            :name(building_id), reference_point(_reference_point), epsg_index(_epsg_index)
+        {
+            CGAL::Polygon_mesh_processing::polygon_soup_to_polygon_mesh(points, polygons, surface);
+            if(!facet_ids.empty())
+            {
+                if(facet_ids.size() != surface.size_of_facets())
+                    throw std::logic_error("There should be as many facet ids as facets!");
+                auto facet_id = std::begin(facet_ids);
+                for(auto facet = surface.facets_begin(); facet != surface.facets_end(); ++facet, ++facet_id)
+                    facet->id() = *facet_id;
+            }
+            if(!surface.empty())
+                bounding_box = CGAL::Polygon_mesh_processing::bbox(surface);
+        }
         UNode::~UNode(void)
         {}
         
@@ -310,6 +418,67 @@ namespace city
                 }
             );
         }
+        UNode & UNode::merge_coplanar_facets(void)
+        {
+            /* Halfedge ids follow the list order: the smallest candidate is the one prunable() would find */
+            std::vector<Halfedge_handle> halfedges;
+            halfedges.reserve(surface.size_of_halfedges());
+            for(auto halfedge = surface.halfedges_begin(); halfedge != surface.halfedges_end(); ++halfedge)
+            {
+                halfedge->id() = halfedges.size();
+                halfedges.push_back(halfedge);
+            }
+
+            std::vector<Vector_3> normals;
+            normals.reserve(surface.size_of_facets());
+            for(auto facet = surface.facets_begin(); facet != surface.facets_end(); ++facet)
+            {
+                facet->id() = normals.size();
+                normals.push_back(CGAL::Polygon_mesh_processing::compute_face_normal(facet, surface));
+            }
+
+            auto joinable = [&normals](Halfedge_handle const& halfedge)
+            {
+                return  !halfedge->is_border_edge()
+                        &&
+                        CGAL::cross_product(normals[halfedge->facet()->id()], normals[halfedge->opposite()->facet()->id()]) == CGAL::NULL_VECTOR;
+            };
+
+            std::set<std::size_t> candidates;
+            for(auto const& halfedge : halfedges)
+                if(joinable(halfedge))
+                    candidates.insert(halfedge->id());
+
+            while(!candidates.empty())
+            {
+                Halfedge_handle halfedge = halfedges[*std::begin(candidates)];
+                candidates.erase(halfedge->id());
+                candidates.erase(halfedge->opposite()->id());
+
+                /* The facet incident to the opposite halfedge is removed */
+                Facet_handle merged = halfedge->facet();
+                surface.join_facet(halfedge);
+                normals[merged->id()] = CGAL::Polygon_mesh_processing::compute_face_normal(merged, surface);
+
+                auto circulator = merged->facet_begin();
+                do
+                {
+                    Halfedge_handle edge = circulator;
+                    if(joinable(edge))
+                    {
+                        candidates.insert(edge->id());
+                        candidates.insert(edge->opposite()->id());
+                    }
+                    else
+                    {
+                        candidates.erase(edge->id());
+                        candidates.erase(edge->opposite()->id());
+                    }
+                }while(++circulator != merged->facet_begin());
+            }
+
+            return *this;
+        }
         std::vector<UNode::Halfedge_handle> UNode::combinable(Facet & facet) const
         {
             std::vector<UNode::Halfedge_handle> combining_edges;
@@ -333,32 +502,28 @@ namespace city
         }
         std::vector<UNode::Halfedge_handle> UNode::pruning_halfedges(void)
         {
-            std::vector<UNode::Halfedge_handle> combining_edges;
+            /* Vertices sharing a point get the same id, so that edges are compared by their endpoints */
+            std::map<Point_3, std::size_t> point_ids;
+            for(auto vertex = surface.vertices_begin(); vertex != surface.vertices_end(); ++vertex)
+                vertex->id() = point_ids.emplace(vertex->point(), point_ids.size()).first->second;
+
+            std::size_t const number_of_points = point_ids.size();
+            std::unordered_set<std::size_t> edges;
+            edges.reserve(surface.size_of_halfedges() / 2);
 
+            std::vector<UNode::Halfedge_handle> combining_edges;
             std::for_each(
                 facets_begin(),
                 facets_end(),
-                [&combining_edges, this](Facet & facet)
+                [&combining_edges, &edges, number_of_points, this](Facet & facet)
                 {
-                    auto buffer = combinable(facet);
-                    std::copy_if(
-                        std::begin(buffer),
-                        std::end(buffer),
-                        std::back_inserter(combining_edges),
-                        [&combining_edges](UNode::Halfedge_handle const& h)
-                        {
-                            return std::none_of(
-                                std::begin(combining_edges),
-                                std::end(combining_edges),
-                                [&h](UNode::Halfedge_handle const& present)
-                                {
-                                    return  (present->vertex()->point() == h->vertex()->point() && present->opposite()->vertex()->point() == h->opposite()->vertex()->point())
-                                            ||
-                                            (present->opposite()->vertex()->point() == h->vertex()->point() && present->vertex()->point() == h->opposite()->vertex()->point());
-                                }
-                            );
-                        }
-                    );
+                    for(auto const& h : combinable(facet))
+                    {
+                        std::size_t const source = h->opposite()->vertex()->id(),
+                                          target = h->vertex()->id();
+                        if(edges.insert(std::min(source, target) * number_of_points + std::max(source, target)).second)
+                            combining_edges.push_back(h);
+                    }
                 }
             );
             return combining_edges;
@@ -466,34 +631,67 @@ namespace city
             );
             return facets;
         }
-        std::vector<bool> UNode::facet_adjacency_matrix(void) const
+        FacetGraph UNode::facet_adjacency(void) const
         {
-            std::vector<bool> matrix(facets_size() * facets_size(), false);
-
-            for(std::size_t diag(0); diag != facets_size(); ++diag)
-                matrix.at(diag * facets_size() + diag) = true;
+            std::unordered_map<UNode::Facet const*, std::size_t> positions;
+            positions.reserve(facets_size());
+            for(auto facet = facets_cbegin(); facet != facets_cend(); ++facet)
+                positions.emplace(&*facet, positions.size());
 
-            auto facets = facet_handles();
+            FacetGraph graph;
+            graph.offsets.reserve(facets_size() + 1);
+            graph.neighbours.reserve(surface.size_of_halfedges());
 
-            std::vector<UNode::Facet_const_handle> line_adjacents;
-            for(std::size_t line(0); line != facets_size(); ++line)
+            std::size_t row(0);
+            for(auto facet = facets_cbegin(); facet != facets_cend(); ++facet, ++row)
             {
-                line_adjacents = facet_adjacents(*facets.at(line));
+                auto row_begin = static_cast<long>(graph.neighbours.size());
+                for(auto adjacent : facet_adjacents(*facet))
+                {
+                    std::size_t column = positions.at(&*adjacent);
+                    if(column != row)
+                        graph.neighbours.push_back(column);
+                }
+                /* Facets sharing several edges are adjacent once */
+                std::sort(std::next(std::begin(graph.neighbours), row_begin), std::end(graph.neighbours));
+                graph.neighbours.erase(
+                    std::unique(std::next(std::begin(graph.neighbours), row_begin), std::end(graph.neighbours)),
+                    std::end(graph.neighbours)
+                );
+                graph.offsets.push_back(graph.neighbours.size());
+            }
+            return graph;
+        }
+        const std::size_t UNode::facet_attributes_size = 10;
 
-                for(auto adjacent : line_adjacents)
+        std::vector<double> UNode::facet_attributes(void) const
+        {
+            std::vector<double> attributes;
+            attributes.reserve(facets_size() * facet_attributes_size);
+            std::for_each(
+                facets_cbegin(),
+                facets_cend(),
+                [&attributes, this](UNode::Facet const& facet)
                 {
-                    auto placeholder = std::find(std::begin(facets), std::end(facets), adjacent);
-                    if(placeholder != std::end(facets))
-                        matrix.at(
-                            line * facets_size()
-                            +
-                            static_cast<std::size_t>(std::distance(std::begin(facets), placeholder))
-                        )
-                        =
-                        true;
+                    auto handle = facet.halfedge()->facet();
+                    Point_3 c = centroid(handle);
+                    Vector_3 n = normal(handle);
+                    std::array<double, 10> row{{
+                        static_cast<double>(facet.id()),
+                        static_cast<double>(facet.facet_degree()),
+                        area(handle),
+                        circumference(handle),
+                        to_double(c.x()), to_double(c.y()), to_double(c.z()),
+                        to_double(n.x()), to_double(n.y()), to_double(n.z())
+                    }};
+                    attributes.insert(std::end(attributes), std::begin(row), std::end(row));
                 }
-            }   
-            return matrix;
+            );
+            return attributes;
+        }
+        std::vector<bool> UNode::facet_adjacency_matrix(void) const
+        {
+            return facet_adjacency().dense();
         }
 
         std::ostream & operator <<(std::ostream &os, UNode const& unode)
@@ -505,18 +703,8 @@ namespace city
 
         io::Adjacency_stream & operator <<(io::Adjacency_stream & as, UNode const& unode)
         {
-            std::for_each(
-                unode.facets_cbegin(),
-                unode.facets_cend(),
-                [&as, &unode](UNode::Facet const& facet)
-                {
-                    as << facet.id() << " " << facet.facet_degree() << " " << unode.area(facet.halfedge()->facet()) << " " << unode.circumference(facet.halfedge()->facet()) << " " << unode.centroid(facet.halfedge()->facet()) << " " << unode.normal(facet.halfedge()->facet()) << std::endl;
-                }
-            );
-
-            std::vector<bool> matrix = unode.facet_adjacency_matrix();
-
-            as << matrix << std::endl;
+            as.print_rows(unode.facet_attributes(), UNode::facet_attributes_size);
+            as << unode.facet_adjacency() << '\n';
 
             return as;
         }
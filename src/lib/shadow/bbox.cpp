@@ -32,7 +32,7 @@ namespace city
                 zmax
             }}
         {}
-        Bbox::Bbox(std::valarray<double> const& coordinates)
+        Bbox::Bbox(std::array<double, 3> const& coordinates)
             : extremes{{
                 coordinates[0],
                 coordinates[0],
@@ -0,0 +1,216 @@
+#include <shadow/flat_mesh.h>
+
+#include <scene/unode.h>
+
+#include <CGAL/Inverse_index.h>
+
+#include <iterator>
+#include <algorithm>
+
+namespace city
+{
+    namespace shadow
+    {
+        FlatMesh::FlatMesh(void)
+        {}
+        FlatMesh::FlatMesh(std::string const& _name)
+            : name(_name)
+        {}
+        FlatMesh::FlatMesh(Mesh const& mesh)
+            : name(mesh.get_name())
+        {
+            std::size_t indices_size(0);
+            std::for_each(
+                mesh.faces_cbegin(),
+                mesh.faces_cend(),
+                [&indices_size](Face const& face)
+                {
+                    indices_size += face.degree();
+                }
+            );
+            reserve(mesh.points_size(), mesh.faces_size(), indices_size);
+
+            std::for_each(
+                mesh.points_cbegin(),
+                mesh.points_cend(),
+                [this](Point const& point)
+                {
+                    add_point(point);
+                }
+            );
+            std::for_each(
+                mesh.faces_cbegin(),
+                mesh.faces_cend(),
+                [this](Face const& face)
+                {
+                    add_face(std::begin(face), std::end(face));
+                }
+            );
+        }
+        FlatMesh::FlatMesh(std::string const& _name, Polyhedron const& polyhedron)
+            : name(_name)
+        {
+            reserve(polyhedron.size_of_vertices(), polyhedron.size_of_facets(), polyhedron.size_of_halfedges());
+
+            std::for_each(
+                polyhedron.points_begin(),
+                polyhedron.points_end(),
+                [this](Point_3 const& point)
+                {
+                    add_point(Point(point));
+                }
+            );
+
+            CGAL::Inverse_index<Polyhedron::Vertex_const_iterator> points_index(polyhedron.vertices_begin(), polyhedron.vertices_end());
+            std::vector<std::size_t> face;
+            std::for_each(
+                polyhedron.facets_begin(),
+                polyhedron.facets_end(),
+                [this, &points_index, &face](Polyhedron::Facet const& facet)
+                {
+                    face.clear();
+                    auto facet_circulator = facet.facet_begin();
+                    do
+                    {
+                        face.push_back(points_index[Polyhedron::Vertex_const_iterator(facet_circulator->vertex())]);
+                    }while(++facet_circulator != facet.facet_begin());
+                    add_face(std::begin(face), std::end(face));
+                }
+            );
+        }
+        FlatMesh::FlatMesh(scene::UNode const& unode)
+            : FlatMesh(unode.get_name(), unode.get_surface())
+        {}
+
+        void FlatMesh::reserve(std::size_t const points, std::size_t const faces, std::size_t const indices_size)
+        {
+            x.reserve(points);
+            y.reserve(points);
+            z.reserve(points);
+            offsets.reserve(faces + 1);
+            indices.reserve(indices_size);
+        }
+        void FlatMesh::add_point(double const _x, double const _y, double const _z)
+        {
+            checked_index(x.size() + 1);
+            x.push_back(_x);
+            y.push_back(_y);
+            z.push_back(_z);
+        }
+        void FlatMesh::add_point(Point const& point)
+        {
+            add_point(point.x(), point.y(), point.z());
+        }
+
+        void FlatMesh::set_name(std::string const& _name)
+        {
+            name = _name;
+        }
+        std::string const& FlatMesh::get_name(void) const noexcept
+        {
+            return name;
+        }
+
+        std::size_t FlatMesh::points_size(void) const noexcept
+        {
+            return x.size();
+        }
+        std::size_t FlatMesh::faces_size(void) const noexcept
+        {
+            return offsets.size() - 1;
+        }
+        std::size_t FlatMesh::indices_size(void) const noexcept
+        {
+            return indices.size();
+        }
+        bool FlatMesh::is_empty(void) const noexcept
+        {
+            return x.empty() && indices.empty();
+        }
+
+        std::vector<double> const& FlatMesh::get_x(void) const noexcept
+        {
+            return x;
+        }
+        std::vector<double> const& FlatMesh::get_y(void) const noexcept
+        {
+            return y;
+        }
+        std::vector<double> const& FlatMesh::get_z(void) const noexcept
+        {
+            return z;
+        }
+        std::vector<std::uint32_t> const& FlatMesh::get_indices(void) const noexcept
+        {
+            return indices;
+        }
+        std::vector<std::uint32_t> const& FlatMesh::get_offsets(void) const noexcept
+        {
+            return offsets;
+        }
+
+        Point FlatMesh::point(std::size_t const index) const
+        {
+            return Point(x.at(index), y.at(index), z.at(index));
+        }
+        std::size_t FlatMesh::face_degree(std::size_t const face) const
+        {
+            return offsets.at(face + 1) - offsets[face];
+        }
+        std::uint32_t const* FlatMesh::face_cbegin(std::size_t const face) const
+        {
+            return indices.data() + offsets.at(face);
+        }
+        std::uint32_t const* FlatMesh::face_cend(std::size_t const face) const
+        {
+            return indices.data() + offsets.at(face + 1);
+        }
+
+        Bbox FlatMesh::bbox(void) const
+        {
+            if(x.empty())
+                return Bbox();
+
+            auto x_range = std::minmax_element(std::begin(x), std::end(x)),
+                 y_range = std::minmax_element(std::begin(y), std::end(y)),
+                 z_range = std::minmax_element(std::begin(z), std::end(z));
+            return Bbox(*x_range.first, *x_range.second, *y_range.first, *y_range.second, *z_range.first, *z_range.second);
+        }
+
+        std::vector<Point_3> FlatMesh::get_cgal_points(void) const
+        {
+            std::vector<Point_3> cgal_points;
+            cgal_points.reserve(points_size());
+            for(std::size_t index(0); index != points_size(); ++index)
+                cgal_points.push_back(Point_3(x[index], y[index], z[index]));
+            return cgal_points;
+        }
+        std::vector< std::vector<std::size_t> > FlatMesh::get_cgal_faces(void) const
+        {
+            std::vector< std::vector<std::size_t> > cgal_faces;
+            cgal_faces.reserve(faces_size());
+            for(std::size_t face(0); face != faces_size(); ++face)
+                cgal_faces.push_back(std::vector<std::size_t>(face_cbegin(face), face_cend(face)));
+            return cgal_faces;
+        }
+
+        Mesh FlatMesh::to_mesh(void) const
+        {
+            std::vector<Point> points;
+            points.reserve(points_size());
+            for(std::size_t index(0); index != points_size(); ++index)
+                points.push_back(Point(x[index], y[index], z[index]));
+
+            std::vector<Face> faces;
+            faces.reserve(faces_size());
+            std::vector<std::size_t> face;
+            for(std::size_t position(0); position != faces_size(); ++position)
+            {
+                face.assign(face_cbegin(position), face_cend(position));
+                faces.push_back(Face(face));
+            }
+
+            return Mesh(name, std::move(points), std::move(faces));
+        }
+    }
+}
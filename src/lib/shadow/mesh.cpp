@@ -9,13 +9,61 @@
 #include <iterator>
 #include <algorithm>
 #include <numeric>
+#include <unordered_map>
 
 #include <limits>
+#include <array>
+
+#include <cmath>
+#include <cstring>
 
 namespace city
 {
     namespace shadow
     {
+        namespace
+        {
+            /** Spatial hash grid cell */
+            using Cell = std::array<long long, 3>;
+
+            struct CellHash
+            {
+                std::size_t operator()(Cell const& cell) const noexcept
+                {
+                    return static_cast<std::size_t>(
+                        static_cast<unsigned long long>(cell[0]) * 73856093ull
+                        ^
+                        static_cast<unsigned long long>(cell[1]) * 19349663ull
+                        ^
+                        static_cast<unsigned long long>(cell[2]) * 83492791ull
+                    );
+                }
+            };
+
+            /**
+             * Computes the grid cell index of a coordinate.
+             * With a zero cell size, the index is the bit pattern of the coordinate, so that only identical coordinates share one.
+             * @param coordinate the coordinate to hash
+             * @param size the cell size
+             * @return the cell index
+             */
+            long long cell_index(double const coordinate, double const size)
+            {
+                if(size == 0)
+                {
+                    /* Adding zero turns -0. into 0. */
+                    double const normalized = coordinate + 0.;
+                    long long bits;
+                    std::memcpy(&bits, &normalized, sizeof(double));
+                    return bits;
+                }
+                double const scaled = std::floor(coordinate / size);
+                if(!(std::fabs(scaled) < 4611686018427387904.))
+                    throw std::out_of_range("The welding tolerance is too small for the point coordinates!");
+                return static_cast<long long>(scaled);
+            }
+        }
+
         Mesh::Mesh(void)
         {}
         Mesh::Mesh(Mesh const& other)
@@ -100,6 +148,12 @@ namespace city
             compute_bbox();
         }
 
+        Mesh::Mesh(std::string const& _name, std::vector<Point> && _points, std::vector<Face> && _faces)
+            : name(_name), points(std::move(_points)), faces(std::move(_faces))
+        {
+            compute_bbox();
+        }
+
         Mesh::Mesh(std::vector<Point> const& _points, std::vector<Face> const& _faces)
             : points(_points), faces(_faces)
         {
@@ -182,7 +236,7 @@ namespace city
         }
 
 
-        Mesh Mesh::set_name(std::string const& _name) noexcept
+        Mesh & Mesh::set_name(std::string const& _name) noexcept
         {
             name = _name;
             return *this;
@@ -278,6 +332,48 @@ namespace city
             return *this;
         }
 
+        void Mesh::append(Mesh const& other)
+        {
+            auto diff = points.size();
+            auto shift = faces.size();
+
+            points.insert(std::end(points), std::begin(other.points), std::end(other.points));
+            faces.insert(std::end(faces), std::begin(other.faces), std::end(other.faces));
+            merge_appended(other, diff, shift);
+        }
+        void Mesh::append(Mesh && other)
+        {
+            auto diff = points.size();
+            auto shift = faces.size();
+
+            points.insert(std::end(points), std::begin(other.points), std::end(other.points));
+            faces.insert(std::end(faces), std::make_move_iterator(std::begin(other.faces)), std::make_move_iterator(std::end(other.faces)));
+            merge_appended(other, diff, shift);
+        }
+        void Mesh::merge_appended(Mesh const& other, std::size_t const diff, std::size_t const shift)
+        {
+            /* Same naming and bounding box as operator+=, which copies `other` into an empty mesh */
+            if(diff == 0)
+            {
+                name = other.name;
+                bounding_box = other.bounding_box;
+            }
+            else
+            {
+                name += "_" + other.name;
+                bounding_box += other.bounding_box;
+            }
+
+            std::for_each(
+                std::next(std::begin(faces), static_cast<long>(shift)),
+                std::end(faces),
+                [diff](Face & face)
+                {
+                    face.offset(diff);
+                }
+            );
+        }
+
         Lib3dsMesh* Mesh::to_3ds(void) const
         {
             char name_buffer[64];
@@ -345,6 +441,104 @@ namespace city
             return os;
         }
 
+        Mesh & Mesh::weld(double const tolerance)
+        {
+            if(!(tolerance >= 0))
+                throw std::out_of_range("The welding tolerance should not be negative!");
+
+            /* Kept points of a cell are chained: `heads` gives the last one of each cell and `chain` the previous one in its cell */
+            std::size_t const none = std::numeric_limits<std::size_t>::max();
+            std::unordered_map<Cell, std::size_t, CellHash> heads;
+            heads.reserve(points.size());
+            std::vector<std::size_t> chain;
+            std::vector<Point> welded;
+            std::vector<std::size_t> remap(points.size());
+
+            /* Cells are four tolerances wide, so that the neighbourhood of a point usually lies in its own cell */
+            double const size = 4 * tolerance,
+                         squared_tolerance = tolerance * tolerance;
+            auto find_in = [&heads, &chain, &welded, none, squared_tolerance](Cell const& cell, Point const& point)
+            {
+                auto head = heads.find(cell);
+                for(std::size_t kept = head == std::end(heads) ? none : head->second; kept != none; kept = chain[kept])
+                {
+                    double squared_distance(0);
+                    for(std::size_t axis(0); axis != 3; ++axis)
+                        squared_distance += (welded[kept].data()[axis] - point.data()[axis]) * (welded[kept].data()[axis] - point.data()[axis]);
+                    if(squared_distance <= squared_tolerance)
+                        return kept;
+                }
+                return none;
+            };
+
+            for(std::size_t index(0); index != points.size(); ++index)
+            {
+                Point const& point = points[index];
+                Cell cell, lower, upper;
+                for(std::size_t axis(0); axis != 3; ++axis)
+                {
+                    cell[axis] = cell_index(point.data()[axis], size);
+                    lower[axis] = cell_index(point.data()[axis] - tolerance, size);
+                    upper[axis] = cell_index(point.data()[axis] + tolerance, size);
+                }
+
+                /* The cell of the point comes first, as it holds most duplicates */
+                std::size_t found = find_in(cell, point);
+                for(long long x(lower[0]); x <= upper[0] && found == none; ++x)
+                    for(long long y(lower[1]); y <= upper[1] && found == none; ++y)
+                        for(long long z(lower[2]); z <= upper[2] && found == none; ++z)
+                            if(Cell{{x, y, z}} != cell)
+                                found = find_in(Cell{{x, y, z}}, point);
+
+                if(found == none)
+                {
+                    found = welded.size();
+                    auto head = heads.insert(std::make_pair(cell, none)).first;
+                    chain.push_back(head->second);
+                    head->second = found;
+                    welded.push_back(point);
+                }
+                remap[index] = found;
+            }
+
+            /* Faces are remapped in place, only those with welded consecutive points being rebuilt */
+            for(auto & face : faces)
+            {
+                std::transform(
+                    std::begin(face),
+                    std::end(face),
+                    std::begin(face),
+                    [&remap](std::size_t const index)
+                    {
+                        return remap[index];
+                    }
+                );
+                if(face.degree() != 0 && (std::adjacent_find(std::begin(face), std::end(face)) != std::end(face) || face[0] == face[face.degree() - 1]))
+                {
+                    std::vector<std::size_t> indices;
+                    std::unique_copy(std::begin(face), std::end(face), std::back_inserter(indices));
+                    while(indices.size() > 1 && indices.front() == indices.back())
+                        indices.pop_back();
+                    face = indices.size() > 2 ? Face(indices) : Face();
+                }
+            }
+            faces.erase(
+                std::remove_if(
+                    std::begin(faces),
+                    std::end(faces),
+                    [](Face const& face)
+                    {
+                        return face.degree() < 3;
+                    }
+                ),
+                std::end(faces)
+            );
+
+            points = std::move(welded);
+            compute_bbox();
+            return *this;
+        }
+
         void Mesh::compute_bbox(void)
         {
             bounding_box = std::accumulate(
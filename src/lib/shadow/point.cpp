@@ -5,10 +5,15 @@
 
 #include <CGAL/number_utils.h>
 
+#include <type_traits>
+#include <stdexcept>
+
 namespace city
 {
     namespace shadow
     {
+        static_assert(std::is_trivially_copyable<Point>::value, "Points are copied as plain coordinates.");
+
         Point::Point(void)
             : coordinates{{0, 0, 0}}
         {}
@@ -19,10 +24,10 @@ namespace city
             : coordinates{{_coordinates[0], _coordinates[1], _coordinates[2]}}
         {}
         Point::Point(std::valarray<double> const& initializer)
-            : coordinates(initializer)
         {
             if(initializer.size() != 3)
                 throw std::logic_error("Cannot create a 3D Point from this entry! Check the size of the initializer.");
+            coordinates = {{initializer[0], initializer[1], initializer[2]}};
         }
         Point::Point(Point_3 const& point)
             : coordinates{{CGAL::to_double(point.x()), CGAL::to_double(point.y()), CGAL::to_double(point.z())}}
@@ -30,20 +35,12 @@ namespace city
         Point::Point(Lib3dsPoint const& point)
             : coordinates{{static_cast<double>(point.pos[0]), static_cast<double>(point.pos[1]), static_cast<double>(point.pos[2])}}
         {}
-        Point::Point(Point const& other)
-            : coordinates(other.coordinates)
-        {}
-        Point::Point(Point && other)
-            : coordinates(std::move(other.coordinates))
-        {}
-        Point::~Point(void)
-        {}
 
-        std::valarray<double> const& Point::data(void) const noexcept
+        std::array<double, 3> const& Point::data(void) const noexcept
         {
             return coordinates;
         }
-        std::valarray<double> & Point::data(void) noexcept
+        std::array<double, 3> & Point::data(void) noexcept
         {
             return coordinates;
         }
@@ -78,20 +75,11 @@ namespace city
             using std::swap;
             swap(coordinates, other.coordinates);
         }
-        Point & Point::operator =(Point const& other) noexcept
-        {
-            coordinates = other.coordinates;
-            return *this;
-        }
-        Point & Point::operator =(Point && other) noexcept
-        {
-            coordinates = std::move(other.coordinates);
-            return *this;
-        }
-
         Point & Point::operator +=(Vector const& translation)
         {
-            coordinates += translation.data();
+            coordinates[0] += translation.x();
+            coordinates[1] += translation.y();
+            coordinates[2] += translation.z();
             return *this;
         }
 
@@ -102,11 +90,11 @@ namespace city
 
         Point operator +(Point const& lhs, Vector const& rhs)
         {
-            return Point(lhs.coordinates + rhs.data());
+            return Point(lhs.x() + rhs.x(), lhs.y() + rhs.y(), lhs.z() + rhs.z());
         }
         bool operator ==(Point const& lhs, Point const& rhs)
         {
-            return (lhs.coordinates == rhs.coordinates).min();
+            return lhs.coordinates == rhs.coordinates;
         }
 
         std::ostream & operator <<(std::ostream & os, Point const& point)
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 
 #include <shadow/point.h>
 
@@ -12,6 +13,8 @@ namespace city
 {
     namespace shadow
     {
+        static_assert(std::is_trivially_copyable<Vector>::value, "Vectors are copied as plain coordinates.");
+
         Vector::Vector(void)
             : coordinates{{0, 0, 0}} 
         {}
@@ -22,28 +25,20 @@ namespace city
             : coordinates{{target.x() - origin.x(), target.y() - origin.y(), target.z() - origin.z()}}
         {}
         Vector::Vector(std::valarray<double> const& initializer)
-            : coordinates(initializer)
         {
             if(initializer.size() != 3)
                 throw std::logic_error("Cannot create a 3D Vector from this entry! Check the size of the initializer.");
+            coordinates = {{initializer[0], initializer[1], initializer[2]}};
         }
         Vector::Vector(double _coordinates[3])
             : coordinates{{_coordinates[0], _coordinates[1], _coordinates[2]}}
         {}
-        Vector::Vector(Vector const& other)
-            : coordinates(other.coordinates)
-        {}
-        Vector::Vector(Vector && other)
-            : coordinates(std::move(other.coordinates))
-        {}
-        Vector::~Vector(void)
-        {}
 
-        std::valarray<double> const& Vector::data(void) const noexcept
+        std::array<double, 3> const& Vector::data(void) const noexcept
         {
             return coordinates;
         }
-        std::valarray<double> & Vector::data(void) noexcept
+        std::array<double, 3> & Vector::data(void) noexcept
         {
             return coordinates;
         }
@@ -79,45 +74,41 @@ namespace city
             swap(coordinates, other.coordinates);
         }
 
-        Vector & Vector::operator =(Vector const& other) noexcept
-        {
-            coordinates = other.coordinates;
-            return *this;
-        }
-
-        Vector & Vector::operator =(Vector && other) noexcept
-        {
-            coordinates = std::move(other.coordinates);
-            return *this;
-        }
-
         Vector & Vector::operator +=(Vector const& other)
         {
-            coordinates += other.coordinates;
+            coordinates[0] += other.coordinates[0];
+            coordinates[1] += other.coordinates[1];
+            coordinates[2] += other.coordinates[2];
             return *this;
         }
 
         Vector & Vector::operator *=(double const scalar)
         {
-            coordinates *= scalar;
+            coordinates[0] *= scalar;
+            coordinates[1] *= scalar;
+            coordinates[2] *= scalar;
             return *this;
         }
 
         Vector & Vector::operator /=(double const scalar)
         {
-            coordinates /= scalar;
+            coordinates[0] /= scalar;
+            coordinates[1] /= scalar;
+            coordinates[2] /= scalar;
             return *this;
         }
 
         Vector & Vector::operator -=(Vector const& other)
         {
-            coordinates -= other.coordinates;
+            coordinates[0] -= other.coordinates[0];
+            coordinates[1] -= other.coordinates[1];
+            coordinates[2] -= other.coordinates[2];
             return *this;
         }
 
         Vector & Vector::operator ^=(Vector const& other)
         {
-            std::valarray<double> coord(coordinates);
+            std::array<double, 3> coord(coordinates);
             coordinates[0] = coord[1] * other.z() - coord[2] * other.y();
             coordinates[1] = coord[2] * other.x() - coord[0] * other.z();
             coordinates[2] = coord[0] * other.y() - coord[1] * other.x();
@@ -133,33 +124,37 @@ namespace city
 
         bool operator ==(Vector const& lhs, Vector const& rhs)
         {
-            return  (lhs.coordinates == rhs.coordinates).min();
+            return lhs.coordinates == rhs.coordinates;
         }
 
 
         Vector operator +(Vector const& lhs, Vector const& rhs)
         {
-            return Vector(lhs.coordinates + rhs.coordinates);
+            Vector result(lhs);
+            return result += rhs;
         }
 
         Vector operator -(Vector const& lhs, Vector const& rhs)
         {
-            return Vector(lhs.coordinates - rhs.coordinates);
+            Vector result(lhs);
+            return result -= rhs;
         }
 
         Vector operator *(double const scalar, Vector const& rhs)
         {
-            return Vector(scalar * rhs.coordinates);
+            Vector result(rhs);
+            return result *= scalar;
         }
 
         Vector operator /(Vector const& lhs, double scalar)
         {
-            return Vector(lhs.coordinates / scalar);
+            Vector result(lhs);
+            return result /= scalar;
         }
 
         double operator *(Vector const& lhs, Vector const& rhs)
         {
-            return (lhs.coordinates * rhs.coordinates).sum();
+            return lhs.coordinates[0] * rhs.coordinates[0] + lhs.coordinates[1] * rhs.coordinates[1] + lhs.coordinates[2] * rhs.coordinates[2];
         }
 
         Vector operator ^(Vector const& lhs, Vector const& rhs)
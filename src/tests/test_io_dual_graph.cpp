@@ -0,0 +1,98 @@
+#include <io/io_dual_graph.h>
+#include <io/io_off.h>
+#include <scene/unode.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+#include <catch.hpp>
+
+SCENARIO("Input/Output from binary dual graph file:")
+{
+    GIVEN("The dual graph of a building")
+    {
+        city::scene::UNode unode(
+            city::io::OFFHandler(
+                boost::filesystem::path("../../ressources/3dModels/OFF/hammerhead.off"),
+                std::map<std::string, bool>{{"read", true}}
+            ).read(),
+            city::shadow::Point(),
+            0
+        );
+        unode.set_face_ids();
+        auto attributes = unode.facet_attributes();
+        auto graph = unode.facet_adjacency();
+
+        std::ostringstream file_name;
+        file_name << boost::uuids::random_generator()() << ".cdg";
+
+        WHEN("it is written and mapped back")
+        {
+            city::io::DualGraphHandler(
+                boost::filesystem::path(file_name.str()),
+                std::map<std::string, bool>{{"write", true}}
+            ).write(attributes, city::scene::UNode::facet_attributes_size, graph);
+
+            city::io::DualGraph dual_graph = city::io::DualGraphHandler(
+                boost::filesystem::path(file_name.str()),
+                std::map<std::string, bool>{{"read", true}}
+            ).read();
+
+            THEN("the attributes and edges check")
+            {
+                REQUIRE(dual_graph.facets_size() == unode.facets_size());
+                REQUIRE(dual_graph.attributes_size() == city::scene::UNode::facet_attributes_size);
+                REQUIRE(dual_graph.edges_size() == graph.edges_size());
+
+                for(std::size_t index(0); index != attributes.size(); ++index)
+                    REQUIRE(dual_graph.attributes()[index] == static_cast<float>(attributes[index]));
+
+                for(std::size_t edge(0); edge != dual_graph.edges_size(); ++edge)
+                {
+                    std::size_t row = dual_graph.edges()[2 * edge], column = dual_graph.edges()[2 * edge + 1];
+                    REQUIRE(row < column);
+                    REQUIRE(std::binary_search(graph.neighbours_cbegin(row), graph.neighbours_cend(row), column));
+                }
+            }
+            boost::filesystem::remove(boost::filesystem::path(file_name.str()));
+        }
+
+        WHEN("the attributes do not match the graph")
+        {
+            attributes.pop_back();
+
+            THEN("the writer throws")
+            {
+                REQUIRE_THROWS_AS(
+                    city::io::DualGraphHandler(
+                        boost::filesystem::path(file_name.str()),
+                        std::map<std::string, bool>{{"write", true}}
+                    ).write(attributes, city::scene::UNode::facet_attributes_size, graph),
+                    std::logic_error
+                );
+            }
+        }
+    }
+    GIVEN("A file which is not a dual graph")
+    {
+        boost::filesystem::path filepath("../../ressources/3dModels/OFF/hammerhead.off");
+
+        WHEN("it is mapped")
+        {
+            THEN("the reader throws")
+            {
+                REQUIRE_THROWS_AS(
+                    city::io::DualGraphHandler(filepath, std::map<std::string, bool>{{"read", true}}).read(),
+                    std::runtime_error
+                );
+            }
+        }
+    }
+}
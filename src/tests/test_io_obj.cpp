@@ -1,6 +1,7 @@
 #include <io/io_obj.h>
 #include <io/io_off.h>
 #include <io/Line/line.h>
+#include <io/Obj_stream/obj_stream.h>
 
 #include <boost/filesystem.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -168,4 +169,46 @@ SCENARIO("Input/Output from obj file:")
             }
         }
     }
+    GIVEN("An obj buffer with comments, texture and normal indexes")
+    {
+        std::string buffer(
+            "# exported\n"
+            "v 0 0 0\n"
+            "v 1.5 0 0\r\n"
+            "v 0 1.5 0 1\n"
+            "vt 0 0\n"
+            "vn 0 0 1\n"
+            "o b\n"
+            "f 1/1/1 2//1 -1\n"
+            "o a # trailing comment\n"
+            "s off\n"
+            "f 3 2\t1\n"
+        );
+
+        WHEN("it is parsed in place")
+        {
+            auto meshes = city::io::Obj_stream::parse(buffer.data(), buffer.data() + buffer.size());
+
+            THEN("the objects are read by name with their own vertices")
+            {
+                REQUIRE(meshes.size() == 2);
+                REQUIRE(meshes.front().get_name() == "a");
+                REQUIRE(meshes.back().get_name() == "b");
+                REQUIRE(meshes.front().points_size() == 3);
+                REQUIRE(meshes.front().faces_size() == 1);
+                REQUIRE(*meshes.front().points_cbegin() == city::shadow::Point(0, 1.5, 0));
+                REQUIRE(*meshes.back().points_cbegin() == city::shadow::Point(0, 0, 0));
+            }
+        }
+
+        WHEN("an index overflows")
+        {
+            buffer.replace(buffer.find("f 3 2"), 5, "f 99999999999999999999 2");
+
+            THEN("the parser throws")
+            {
+                REQUIRE_THROWS_AS(city::io::Obj_stream::parse(buffer.data(), buffer.data() + buffer.size()), std::out_of_range);
+            }
+        }
+    }
 }
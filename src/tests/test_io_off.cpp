@@ -1,5 +1,7 @@
 #include <io/io_off.h>
 #include <io/Line/line.h>
+#include <io/Off_stream/off_stream.h>
+#include <io/Point_format/point_format.h>
 
 #include <boost/filesystem.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -11,6 +13,7 @@
 #include <algorithm>
 #include <iterator>
 #include <fstream>
+#include <sstream>
 #include <streambuf>
 
 #include <catch.hpp>
@@ -123,4 +126,141 @@ SCENARIO("Input/Output from OFF file:")
             }
         }
     }
+    GIVEN("A COFF buffer with inline comments and facet colors")
+    {
+        std::string buffer(
+            "# exported\n"
+            "COFF 4 2 0 # sizes on the header line\n"
+            "0 0 0 255 0 0 255\n"
+            "1.5 0 0 255 0 0 255 # red\r\n"
+            "\n"
+            "0 1.5 0 255 0 0 255\n"
+            "0 0 1.5 255 0 0 255\n"
+            "3 0 1 2 0.5 0.5 0.5\n"
+            "# last facet\n"
+            "3 0 1 3\n"
+        );
+
+        WHEN("it is parsed in place")
+        {
+            city::shadow::Mesh mesh = city::io::Off_stream::parse(buffer.data(), buffer.data() + buffer.size());
+
+            THEN("the colors and comments are skipped")
+            {
+                REQUIRE(mesh.points_size() == 4);
+                REQUIRE(mesh.faces_size() == 2);
+                REQUIRE(*std::next(mesh.points_cbegin()) == city::shadow::Point(1.5, 0, 0));
+                REQUIRE(std::next(mesh.faces_cbegin())->indexes() == std::vector<std::size_t>{0, 1, 3});
+            }
+        }
+
+        WHEN("the header is not an OFF variant")
+        {
+            buffer.replace(0, 15, "# exported\n4OFF");
+
+            THEN("the parser throws")
+            {
+                REQUIRE_THROWS_AS(city::io::Off_stream::parse(buffer.data(), buffer.data() + buffer.size()), std::ios_base::failure);
+            }
+        }
+
+        WHEN("a facet refers to a missing point")
+        {
+            buffer.replace(buffer.rfind("3 0 1 3"), 7, "3 0 1 4");
+
+            THEN("the parser throws")
+            {
+                REQUIRE_THROWS_AS(city::io::Off_stream::parse(buffer.data(), buffer.data() + buffer.size()), std::range_error);
+            }
+        }
+
+        WHEN("a point misses a coordinate")
+        {
+            buffer.replace(buffer.find("0 1.5 0 255 0 0 255"), 19, "0 1.5");
+
+            THEN("the parser throws instead of reading on the next line")
+            {
+                REQUIRE_THROWS_AS(city::io::Off_stream::parse(buffer.data(), buffer.data() + buffer.size()), std::range_error);
+            }
+        }
+
+        WHEN("the header announces more points than the buffer holds")
+        {
+            buffer.replace(buffer.find("COFF 4"), 6, "COFF 4000000000000");
+
+            THEN("the parser throws a parse error")
+            {
+                REQUIRE_THROWS_AS(city::io::Off_stream::parse(buffer.data(), buffer.data() + buffer.size()), std::range_error);
+            }
+        }
+    }
+
+    GIVEN("A mesh with coordinates needing every significant digit")
+    {
+        std::string buffer(
+            "OFF\n"
+            "3 1 0\n"
+            "0.1 651234.123456789 0.3333333333333333\n"
+            "-1e-7 6862345.987654321 2.5\n"
+            "1234.5678 0 -0.30000000000000004\n"
+            "3 0 1 2\n"
+        );
+        city::shadow::Mesh mesh = city::io::Off_stream::parse(buffer.data(), buffer.data() + buffer.size());
+
+        WHEN("it is written to an OFF stream and parsed back")
+        {
+            std::stringstream output;
+            city::io::Off_stream os(output);
+            os << mesh;
+            std::string text(output.str());
+
+            THEN("the points are read back exactly")
+            {
+                REQUIRE(city::io::Off_stream::parse(text.data(), text.data() + text.size()) == mesh);
+                REQUIRE(text.find("0.1 651234.123456789 0.333333333333333") != std::string::npos);
+            }
+        }
+
+        WHEN("it is written with millimetre precision")
+        {
+            std::stringstream output;
+            city::io::Off_stream os(output, 3);
+            os << mesh;
+            std::string text(output.str());
+
+            THEN("the coordinates are rounded to three decimals")
+            {
+                REQUIRE(text.find("0.1 651234.123 0.333\n0 6862345.988 2.5\n1234.568 0 -0.3\n") != std::string::npos);
+            }
+        }
+
+        WHEN("a vector is formatted")
+        {
+            city::shadow::Vector vector(-0.1, 1e-7, 2.0000004);
+            char text[city::io::Point_format::max_length];
+            std::string round_trip(text, city::io::Point_format().print(vector, text));
+            std::string millimetres(text, city::io::Point_format(3).print(vector, text));
+
+            std::stringstream output;
+            {
+                city::io::Buffered_stream out(output);
+                city::io::Point_format(3).write(out, vector) << '\n';
+            }
+
+            THEN("its coordinates are written like those of a point")
+            {
+                REQUIRE(round_trip == "-0.1 0.0000001 2.0000004");
+                REQUIRE(millimetres == "-0.1 0 2");
+                REQUIRE(output.str() == "-0.1 0 2\n");
+            }
+        }
+
+        WHEN("the precision is out of range")
+        {
+            THEN("the format throws")
+            {
+                REQUIRE_THROWS_AS(city::io::Point_format(10), std::out_of_range);
+            }
+        }
+    }
 }
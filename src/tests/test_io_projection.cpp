@@ -8,6 +8,9 @@
 #include <boost/uuid/uuid_io.hpp>
 
 #include <string>
+#include <algorithm>
+
+#include <cmath>
 #include <fstream>
 #include <streambuf>
 
@@ -62,6 +65,85 @@ SCENARIO("Input/Output from Shadow Mesh:")
                 REQUIRE(read_proj.data() == test_footprint.data());
             }
         }
+        WHEN("the projection is rasterized on several tiles and threads")
+        {
+            city::projection::RasterPrint serial(test_footprint, .05, city::projection::Rasterization::scanline, 1);
+            city::projection::RasterPrint parallel(test_footprint, .05, city::projection::Rasterization::scanline, 4);
+            THEN("The output is the same as the serial one:")
+            {
+                REQUIRE(serial.get_height() > 128);
+                REQUIRE(serial.get_width() > 128);
+                REQUIRE(std::equal(std::begin(serial), std::end(serial), std::begin(parallel)));
+                bool same_hits = true;
+                for(std::size_t i(0); i != serial.get_height(); ++i)
+                    for(std::size_t j(0); j != serial.get_width(); ++j)
+                        same_hits = same_hits && serial.hit(i, j) == parallel.hit(i, j);
+                REQUIRE(same_hits);
+            }
+            THEN("The output is the same as the untiled one:")
+            {
+                std::size_t const height(serial.get_height()), width(serial.get_width());
+                std::vector<double> image(height * width, 0.);
+                std::vector<short> hits(height * width, 0);
+                city::shadow::Point top_left(test_footprint.bbox().xmin(), test_footprint.bbox().ymax(), 0);
+                for(auto const& facet : test_footprint)
+                    facet.rasterize(image, hits, top_left, height, width, .05, city::projection::Rasterization::scanline);
+
+                REQUIRE(std::equal(std::begin(image), std::end(image), std::begin(serial)));
+                REQUIRE(std::equal(std::begin(image), std::end(image), std::begin(parallel)));
+                bool same_hits = true;
+                for(std::size_t i(0); i != height; ++i)
+                    for(std::size_t j(0); j != width; ++j)
+                        same_hits = same_hits && hits[i * width + j] == serial.hit(i, j) && hits[i * width + j] == parallel.hit(i, j);
+                REQUIRE(same_hits);
+            }
+        }
+        WHEN("the projection is streamed to a tiled GeoTIFF")
+        {
+            file_name << boost::uuids::random_generator()() << ".geotiff";
+            city::io::RasterHandler handler(
+                boost::filesystem::path(file_name.str()),
+                std::map<std::string,bool>{{"write", true}, {"read", true}}
+            );
+            handler.write(test_footprint, .05, 2);
+            THEN("The output checks:")
+            {
+                city::projection::RasterPrint rasta(test_footprint, .05, city::projection::Rasterization::scanline);
+                city::projection::RasterPrint read_proj = handler.read();
+                REQUIRE(read_proj.get_height() == rasta.get_height());
+                REQUIRE(read_proj.get_width() == rasta.get_width());
+                REQUIRE(std::equal(std::begin(rasta), std::end(rasta), std::begin(read_proj)));
+            }
+        }
+        WHEN("the projection is rasterized and written to a centimetre quantized GeoTIFF")
+        {
+            file_name << boost::uuids::random_generator()() << ".geotiff";
+            city::io::RasterHandler handler(
+                boost::filesystem::path(file_name.str()),
+                std::map<std::string,bool>{{"write", true}, {"read", true}}
+            );
+            city::projection::RasterPrint rasta(test_footprint, 1);
+            rasta.set_sample_format(city::projection::SampleFormat(city::projection::SampleType::int16, .01, -5.));
+            handler.write(rasta);
+            THEN("The heights round-trip within half a centimetre:")
+            {
+                city::projection::RasterPrint read_proj = handler.read();
+                REQUIRE(read_proj.get_sample_format().type == city::projection::SampleType::int16);
+                REQUIRE(read_proj.get_sample_format().scale == Approx(.01));
+                REQUIRE(read_proj.get_sample_format().offset == Approx(-5.));
+                REQUIRE(
+                    std::equal(
+                        std::begin(rasta),
+                        std::end(rasta),
+                        std::begin(read_proj),
+                        [](double const lhs, double const rhs)
+                        {
+                            return std::abs(lhs - rhs) <= .005 + 1e-9;
+                        }
+                    )
+                );
+            }
+        }
         WHEN("the projection is rasterized and written to a GeoTIFF")
         {
             file_name << boost::uuids::random_generator()() << ".geotiff";
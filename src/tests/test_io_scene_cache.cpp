@@ -0,0 +1,121 @@
+#include <io/io_scene_cache.h>
+#include <io/io_off.h>
+#include <io/io_scene.h>
+#include <scene/scene.h>
+#include <algorithms/unode_algorithms.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+
+#include <catch.hpp>
+
+SCENARIO("Input/Output from binary scene cache file:")
+{
+    GIVEN("A scene with a pruned building")
+    {
+        city::shadow::Point pivot(650000, 6860000, 0);
+        auto mesh = city::io::OFFHandler(
+            boost::filesystem::path("../../ressources/3dModels/OFF/hammerhead.off"),
+            std::map<std::string, bool>{{"read", true}}
+        ).read();
+        city::scene::UNode building(mesh, pivot, 2154);
+        city::prune(building);
+        std::vector<city::scene::UNode> buildings{building};
+        city::scene::Scene scene(std::move(buildings), city::scene::UNode(mesh, pivot, 2154), pivot, 2154);
+
+        std::ostringstream file_name;
+        file_name << boost::uuids::random_generator()() << ".cache";
+
+        WHEN("it is written and mapped back")
+        {
+            city::io::SceneCacheHandler(
+                boost::filesystem::path(file_name.str()),
+                std::map<std::string, bool>{{"write", true}}
+            ).write(scene, true, false);
+
+            city::io::SceneCache cache = city::io::SceneCacheHandler(
+                boost::filesystem::path(file_name.str()),
+                std::map<std::string, bool>{{"read", true}}
+            ).read();
+            city::scene::Scene cached_scene = cache.to_scene(2);
+
+            THEN("the scene checks")
+            {
+                REQUIRE(cache.buildings_size() == 1);
+                REQUIRE(cache.pruned_buildings());
+                REQUIRE(!cache.pruned_terrain());
+                REQUIRE(cached_scene.get_pivot() == pivot);
+                REQUIRE(cached_scene.get_epsg() == 2154);
+
+                city::scene::UNode const& cached_building = *cached_scene.cbegin();
+                REQUIRE(cached_building.get_name() == building.get_name());
+                REQUIRE(cached_building.vertices_size() == building.vertices_size());
+                REQUIRE(cached_building.facets_size() == building.facets_size());
+                REQUIRE(city::shadow::Mesh(cached_building) == city::shadow::Mesh(building));
+                REQUIRE(std::prev(cached_building.facets_cend())->id() == building.facets_size() - 1);
+
+                REQUIRE(cached_scene.get_terrain().facets_size() == scene.get_terrain().facets_size());
+            }
+            boost::filesystem::remove(boost::filesystem::path(file_name.str()));
+        }
+
+        WHEN("it is cached with the stamp of its source scene")
+        {
+            boost::filesystem::path directory(boost::filesystem::unique_path());
+            boost::filesystem::create_directory(directory);
+            boost::filesystem::path scene_path(directory / "scene.obj");
+            std::ofstream(scene_path.string()) << "v 0 0 0\n";
+
+            auto stamp = city::io::SceneCacheSource::stamp(scene_path, city::io::SceneFormat::obj, .01);
+            city::io::SceneCacheHandler(
+                directory / "scene.cache",
+                std::map<std::string, bool>{{"write", true}}
+            ).write(scene, true, false, stamp);
+            city::io::SceneCache cache = city::io::SceneCacheHandler(
+                directory / "scene.cache",
+                std::map<std::string, bool>{{"read", true}}
+            ).read();
+
+            THEN("the stamp only matches the same source and options")
+            {
+                REQUIRE(cache.source() == stamp);
+                REQUIRE(cache.source() == city::io::SceneCacheSource::stamp(scene_path, city::io::SceneFormat::obj, .01));
+                REQUIRE(cache.source() != city::io::SceneCacheSource::stamp(scene_path, city::io::SceneFormat::obj, city::scene::Scene::no_welding));
+                REQUIRE(cache.source() != city::io::SceneCacheSource::stamp(scene_path, city::io::SceneFormat::off, .01));
+
+                std::ofstream(scene_path.string(), std::ios::app) << "v 1 0 0\n";
+                REQUIRE(cache.source() != city::io::SceneCacheSource::stamp(scene_path, city::io::SceneFormat::obj, .01));
+            }
+            THEN("the outputs written next to the scene do not stale the cache")
+            {
+                for(auto const& extension : {".shp", ".shx", ".dbf", ".tiff"})
+                    std::ofstream((directory / ("scene" + std::string(extension))).string()) << "output";
+                REQUIRE(cache.source() == city::io::SceneCacheSource::stamp(scene_path, city::io::SceneFormat::obj, .01));
+            }
+            boost::filesystem::remove_all(directory);
+        }
+    }
+    GIVEN("A file which is not a scene cache")
+    {
+        boost::filesystem::path filepath("../../ressources/3dModels/OFF/hammerhead.off");
+
+        WHEN("it is mapped")
+        {
+            THEN("the reader throws")
+            {
+                REQUIRE_THROWS_AS(
+                    city::io::SceneCacheHandler(filepath, std::map<std::string, bool>{{"read", true}}).read(),
+                    std::runtime_error
+                );
+            }
+        }
+    }
+}
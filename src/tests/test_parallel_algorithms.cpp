@@ -0,0 +1,126 @@
+#include <algorithms/parallel_algorithms.h>
+#include <algorithms/util_algorithms.h>
+
+#include <catch.hpp>
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+
+SCENARIO("Parallel algorithms")
+{
+    GIVEN("A range of integers")
+    {
+        std::vector<std::size_t> input(1000);
+        std::iota(std::begin(input), std::end(input), 0);
+
+        WHEN("it is transformed with several workers")
+        {
+            std::vector<std::size_t> output(input.size());
+            city::parallel_transform(
+                std::begin(input),
+                std::end(input),
+                std::begin(output),
+                [](std::size_t const value)
+                {
+                    return 2 * value;
+                },
+                4
+            );
+
+            THEN("the output keeps the input order")
+            {
+                std::vector<std::size_t> expected(input.size());
+                std::transform(
+                    std::begin(input),
+                    std::end(input),
+                    std::begin(expected),
+                    [](std::size_t const value)
+                    {
+                        return 2 * value;
+                    }
+                );
+                REQUIRE(output == expected);
+            }
+        }
+
+        WHEN("a work item throws")
+        {
+            THEN("the exception is forwarded to the caller")
+            {
+                REQUIRE_THROWS_AS(
+                    city::parallel_for(
+                        input.size(),
+                        [](std::size_t const index)
+                        {
+                            if(index == 500)
+                                throw std::runtime_error("failing work item");
+                        },
+                        4
+                    ),
+                    std::runtime_error
+                );
+            }
+        }
+    }
+}
+
+SCENARIO("Progress counter")
+{
+    GIVEN("A counter over many work items")
+    {
+        std::ostringstream output;
+        city::ProgressCounter progress("Reading... ", 1000, output);
+
+        WHEN("the work items are counted by several workers")
+        {
+            city::parallel_for(
+                1000,
+                [&progress](std::size_t const)
+                {
+                    progress();
+                },
+                4
+            );
+
+            THEN("every item is counted and the last update shows the total")
+            {
+                REQUIRE(progress.count() == 1000);
+                std::string const printed = output.str();
+                REQUIRE(printed.substr(printed.rfind('\r') + 1) == "Reading... 1000/1000 ");
+                REQUIRE(std::count(std::begin(printed), std::end(printed), '\r') <= 100);
+            }
+        }
+    }
+}
+
+SCENARIO("Spatial ordering")
+{
+    GIVEN("Boxes laid out on a grid")
+    {
+        std::vector<city::Bbox_2> boxes{
+            city::Bbox_2(10., 10., 11., 11.),
+            city::Bbox_2(0., 0., 1., 1.),
+            city::Bbox_2(10., 0., 11., 1.),
+            city::Bbox_2(0., 10., 1., 11.),
+            city::Bbox_2(0.5, 0.5, 1., 1.)
+        };
+
+        WHEN("they are ordered along the curve")
+        {
+            auto order = city::spatial_order(boxes);
+
+            THEN("every box appears once and neighbours stay together")
+            {
+                std::vector<std::size_t> sorted(order);
+                std::sort(std::begin(sorted), std::end(sorted));
+                REQUIRE(sorted == std::vector<std::size_t>({0, 1, 2, 3, 4}));
+                REQUIRE(order.front() == 1);
+                REQUIRE(order[1] == 4);
+                REQUIRE(order.back() == 0);
+            }
+        }
+    }
+}
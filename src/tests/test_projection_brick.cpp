@@ -5,6 +5,7 @@
 #include <catch.hpp>
 
 #include <vector>
+#include <utility>
 
 #include <ostream>
 #include <sstream>
@@ -91,6 +92,84 @@ SCENARIO("Brick projection manipulation")
                 REQUIRE(auxilary.str() == "Bounding box: -1 0 1 1\nFace Projections: 2\nId: 1\nThe Polygon describing borders :3 -1 0 1 0 0 1  1 3 0.5 0.33 -0.5 0.33 0 0.67  \nThe supporting plane coefficients : 3 -0.23 2 -7\n\nId: 2\nThe Polygon describing borders :3 -0.5 0.33 0.5 0.33 0 0.67  0 \nThe supporting plane coefficients : 0 -3.2 0.34 -0.644\n\n");
             }
         }
+        WHEN("face_2 is moved into the other")
+        {
+            city::projection::BrickPrint proj(face_1), other(face_2), empty;
+            proj += std::move(other);
+            empty += city::projection::BrickPrint(face_1);
+            THEN("The output is the same as with a copy:")
+            {
+                REQUIRE(proj == (city::projection::BrickPrint(face_1) + city::projection::BrickPrint(face_2)));
+                REQUIRE(other.is_empty());
+                REQUIRE(empty == city::projection::BrickPrint(face_1));
+            }
+        }
+    }
+
+    GIVEN("A Brick Print and a distant facet")
+    {
+        city::InexactToExact to_exact;
+        auto face_1 = test_facet_projection(
+            1,
+            to_exact(city::InexactKernel::Point_3(-1., 0, 5.)),
+            to_exact(city::InexactKernel::Point_3(1., 0., 2.)),
+            to_exact(city::InexactKernel::Point_3(0, 1., 3.615))
+        );
+        auto face_3 = test_facet_projection(
+            3,
+            to_exact(city::InexactKernel::Point_3(99., 100., 5.)),
+            to_exact(city::InexactKernel::Point_3(101., 100., 2.)),
+            to_exact(city::InexactKernel::Point_3(100., 101., 3.615))
+        );
+
+        WHEN("the distant facet is added to the other")
+        {
+            auto proj = city::projection::BrickPrint(face_1) + city::projection::BrickPrint(face_3);
+            THEN("both facets are kept untouched")
+            {
+                REQUIRE(proj.size() == 2);
+                REQUIRE((proj.contains(face_1) && proj.contains(face_3)));
+                REQUIRE(proj == (city::projection::BrickPrint(face_3) + city::projection::BrickPrint(face_1)));
+            }
+        }
+        WHEN("an overlapping facet is added afterwards")
+        {
+            auto face_2 = test_facet_projection(
+                2,
+                to_exact(city::InexactKernel::Point_3(-.5, .33, 5.)),
+                to_exact(city::InexactKernel::Point_3(.5, .33, 5.)),
+                to_exact(city::InexactKernel::Point_3(0, .67, 8.2))
+            );
+            auto proj = city::projection::BrickPrint(face_1) + city::projection::BrickPrint(face_3) + city::projection::BrickPrint(face_2);
+            THEN("only the overlapped facet is cut")
+            {
+                REQUIRE(proj == (city::projection::BrickPrint(face_1) + city::projection::BrickPrint(face_2) + city::projection::BrickPrint(face_3)));
+                REQUIRE(!proj.overlaps(test_facet_projection(4, std::vector<city::Point_2>{{city::Point_2(10, 10), city::Point_2(11, 10), city::Point_2(10, 11)}}, face_3.get_plane())));
+            }
+        }
+        WHEN("facets are added once the facets union is built")
+        {
+            auto face_2 = test_facet_projection(
+                2,
+                to_exact(city::InexactKernel::Point_3(-.5, .33, 5.)),
+                to_exact(city::InexactKernel::Point_3(.5, .33, 5.)),
+                to_exact(city::InexactKernel::Point_3(0, .67, 8.2))
+            );
+            city::projection::BrickPrint proj(face_1);
+            proj.facets_union();
+            proj += face_3;
+            proj += face_2;
+            THEN("the maintained union is the union of the facets")
+            {
+                city::Polygon_set expected;
+                for(auto const& facet : proj)
+                    expected.join(facet.get_polygon());
+                city::Polygon_set difference(proj.facets_union());
+                difference.symmetric_difference(expected);
+                REQUIRE(difference.is_empty());
+                REQUIRE(proj == (city::projection::BrickPrint(face_1) + city::projection::BrickPrint(face_3) + city::projection::BrickPrint(face_2)));
+            }
+        }
     }
 
     GIVEN("two non convexe facets")
@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <iterator>
+#include <algorithm>
 
 #include <limits>
 
@@ -218,5 +219,29 @@ SCENARIO("Face Projection manipulation:")
                 REQUIRE(!example.contains(city::Point_2(0, 0)));
             }
         }
+        WHEN("the face is rasterized on a grid aligned with its edges")
+        {
+            std::size_t const height(10), width(6);
+            std::vector<double> exact_image(height * width, 0.), scanline_image(height * width, 0.);
+            std::vector<short> exact_hits(height * width, 0), scanline_hits(height * width, 0);
+            example.rasterize(exact_image, exact_hits, city::shadow::Point(-3, 5, 0), height, width, 1., city::projection::Rasterization::exact);
+            example.rasterize(scanline_image, scanline_hits, city::shadow::Point(-3, 5, 0), height, width, 1., city::projection::Rasterization::scanline);
+            THEN("the scanline and exact rasterizations agree:")
+            {
+                REQUIRE(scanline_hits == exact_hits);
+                REQUIRE(std::count(std::begin(scanline_hits), std::end(scanline_hits), 1) == 48);
+                REQUIRE(
+                    std::equal(
+                        std::begin(scanline_image),
+                        std::end(scanline_image),
+                        std::begin(exact_image),
+                        [](double const lhs, double const rhs)
+                        {
+                            return std::abs(lhs - rhs) < 1e-9;
+                        }
+                    )
+                );
+            }
+        }
     }
 }
@@ -0,0 +1,52 @@
+#include <algorithms/raster_algorithms.h>
+
+#include <catch.hpp>
+
+#include <vector>
+
+SCENARIO("Plane row accumulation")
+{
+    GIVEN("A partially hit raster row")
+    {
+        std::size_t const width(1003);
+        std::vector<double> image(width, 0.);
+        std::vector<short> hits(width, 0);
+        for(std::size_t index(0); index != width; ++index)
+        {
+            hits[index] = static_cast<short>(index % 3);
+            image[index] = hits[index] ? .25 * static_cast<double>(index % 7) : 0.;
+        }
+
+        WHEN("a plane row is accumulated with the dispatched and the scalar kernels")
+        {
+            std::vector<double> reference_image(image);
+            std::vector<short> reference_hits(hits);
+            city::accumulate_plane_row(image.data() + 1, hits.data() + 1, width - 2, 12.5, -.06);
+            city::accumulate_plane_row_scalar(reference_image.data() + 1, reference_hits.data() + 1, width - 2, 12.5, -.06);
+
+            THEN("the rows are identical")
+            {
+                REQUIRE(image == reference_image);
+                REQUIRE(hits == reference_hits);
+                REQUIRE(hits.front() == 0);
+                REQUIRE(hits[1] == 2);
+                REQUIRE(image[1] == Approx(6.375));
+            }
+        }
+
+        WHEN("the same row is accumulated in two spans")
+        {
+            std::vector<double> reference_image(image);
+            std::vector<short> reference_hits(hits);
+            city::accumulate_plane_row(image.data(), hits.data(), 129, 12.5, -.06, 0);
+            city::accumulate_plane_row(image.data() + 129, hits.data() + 129, width - 129, 12.5, -.06, 129);
+            city::accumulate_plane_row_scalar(reference_image.data(), reference_hits.data(), width, 12.5, -.06);
+
+            THEN("the heights are those of a single span")
+            {
+                REQUIRE(image == reference_image);
+                REQUIRE(hits == reference_hits);
+            }
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include <shadow/mesh.h>
+#include <shadow/flat_mesh.h>
 #include <io/io_off.h>
 
 #include <boost/filesystem.hpp>
@@ -6,9 +7,12 @@
 #include <catch.hpp>
 
 #include <map>
+#include <vector>
+#include <string>
 #include <initializer_list>
 #include <iterator>
 #include <algorithm>
+#include <numeric>
 
 #include <fstream>
 
@@ -147,5 +151,132 @@ SCENARIO("shadow::Mesh manipulation:")
                 REQUIRE(mesh == test_mesh);
             }
         }
+        WHEN("they are concatenated at once")
+        {
+            std::vector<city::shadow::Mesh> parts;
+            for(auto const& stem : {"F29051", "F29054", "F29057", "F29060", "F29063", "F29066", "F29069", "T11107", "T11108"})
+                parts.push_back(
+                    city::io::OFFHandler(
+                        boost::filesystem::path("../../ressources/3dModels/OFF/" + std::string(stem) + ".off"),
+                        std::map<std::string, bool>{{"read", true}}
+                    ).read()
+                );
+            auto sum = std::accumulate(std::begin(parts), std::end(parts), city::shadow::Mesh());
+            auto copied = city::shadow::Mesh::concatenate(std::begin(parts), std::end(parts));
+            auto moved = city::shadow::Mesh::concatenate(std::make_move_iterator(std::begin(parts)), std::make_move_iterator(std::end(parts)));
+
+            THEN("The output is the stitched mesh:")
+            {
+                auto test_mesh = city::io::OFFHandler(
+                    boost::filesystem::path("../../ressources/tests/building_sum_mesh.off"),
+                    std::map<std::string, bool>{{"read", true}}
+                ).read();
+
+                REQUIRE(copied == test_mesh);
+                REQUIRE(moved == test_mesh);
+                REQUIRE(moved.get_name() == sum.get_name());
+                REQUIRE(moved.bbox().to_cgal() == sum.bbox().to_cgal());
+            }
+        }
+    }
+}
+
+SCENARIO("shadow::Mesh welding:")
+{
+    GIVEN("A mesh with duplicate and nearly coincident points")
+    {
+        std::vector<city::shadow::Point> points{
+            city::shadow::Point(0, 0, 0), city::shadow::Point(1, 0, 0), city::shadow::Point(0, 1, 0),
+            city::shadow::Point(1, 0, 0), city::shadow::Point(1, 1, 0), city::shadow::Point(0, 1, 0),
+            city::shadow::Point(5, 5, 5), city::shadow::Point(5, 5, 5.0001), city::shadow::Point(5.0001, 5, 5)
+        };
+        std::vector<city::shadow::Face> faces{
+            city::shadow::Face{0, 1, 2},
+            city::shadow::Face{3, 4, 5},
+            city::shadow::Face{6, 7, 8}
+        };
+        city::shadow::Mesh mesh("welding", points, faces);
+
+        WHEN("it is welded with a zero tolerance")
+        {
+            mesh.weld(0);
+
+            THEN("only identical points are merged")
+            {
+                REQUIRE(mesh.points_size() == 7);
+                REQUIRE(mesh.faces_size() == 3);
+                REQUIRE((std::next(mesh.faces_cbegin())->indexes() == std::vector<std::size_t>{1, 3, 2}));
+            }
+        }
+        WHEN("it is welded with a millimetre tolerance")
+        {
+            mesh.weld(1e-3);
+
+            THEN("close points are merged and the collapsed face is dropped")
+            {
+                REQUIRE(mesh.points_size() == 5);
+                REQUIRE(mesh.faces_size() == 2);
+                REQUIRE(*std::prev(mesh.points_cend()) == city::shadow::Point(5, 5, 5));
+                REQUIRE(mesh.bbox().zmax() == 5);
+            }
+        }
+        WHEN("the tolerance is negative")
+        {
+            THEN("it is rejected")
+            {
+                REQUIRE_THROWS_AS(mesh.weld(-1), std::out_of_range);
+            }
+        }
+    }
+}
+
+SCENARIO("shadow::FlatMesh conversion:")
+{
+    GIVEN("An OFF file")
+    {
+        city::io::OFFHandler handler(
+            boost::filesystem::path("../../ressources/3dModels/OFF/hammerhead.off"),
+            std::map<std::string, bool>{{"read", true}}
+        );
+        city::shadow::Mesh mesh = handler.read();
+
+        WHEN("it is read as a flat mesh")
+        {
+            city::shadow::FlatMesh flat_mesh = handler.read_flat();
+
+            THEN("it holds the same points and faces")
+            {
+                REQUIRE(flat_mesh.get_name() == mesh.get_name());
+                REQUIRE(flat_mesh.points_size() == mesh.points_size());
+                REQUIRE(flat_mesh.faces_size() == mesh.faces_size());
+                REQUIRE(flat_mesh.point(1) == *std::next(mesh.points_cbegin()));
+                REQUIRE(std::vector<std::size_t>(flat_mesh.face_cbegin(1), flat_mesh.face_cend(1)) == std::next(mesh.faces_cbegin())->indexes());
+                REQUIRE(flat_mesh.to_mesh() == mesh);
+            }
+        }
+
+        WHEN("the mesh is flattened")
+        {
+            city::shadow::FlatMesh flat_mesh(mesh);
+
+            THEN("the conversion back gives the same mesh")
+            {
+                REQUIRE(flat_mesh.get_offsets().back() == flat_mesh.indices_size());
+                REQUIRE(flat_mesh.to_mesh() == mesh);
+            }
+        }
+
+        WHEN("a face refers to a missing point")
+        {
+            city::shadow::FlatMesh flat_mesh(mesh);
+            std::vector<std::size_t> face{0, 1, mesh.points_size()};
+
+            THEN("it is rejected and the mesh is left unchanged")
+            {
+                REQUIRE_THROWS_AS(flat_mesh.add_face(std::begin(face), std::end(face)), std::out_of_range);
+                REQUIRE(flat_mesh.faces_size() == mesh.faces_size());
+                REQUIRE(flat_mesh.to_mesh() == mesh);
+            }
+        }
     }
 }
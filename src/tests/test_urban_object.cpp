@@ -1,13 +1,67 @@
 #include <scene/unode.h>
+#include <scene/scene.h>
+#include <algorithms/unode_algorithms.h>
 #include <io/io_3ds.h>
+#include <io/io_off.h>
 
 #include <boost/filesystem.hpp>
 
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <sstream>
 #include <fstream>
 
 #include <catch.hpp>
 
+namespace
+{
+    /* Reference pruning: joins the first prunable halfedge until none is left */
+    city::scene::UNode & prune_from_scratch(city::scene::UNode & unode)
+    {
+        for(auto halfedge = unode.prunable(); halfedge != unode.halfedges_end(); halfedge = unode.prunable())
+            unode.join_facet(halfedge);
+        return unode.stitch_borders().set_face_ids();
+    }
+
+    /* Reference deduplication: compares every candidate with the edges collected so far */
+    std::vector<city::scene::UNode::Halfedge_handle> pruning_halfedges_from_scratch(city::scene::UNode & unode)
+    {
+        std::vector<city::scene::UNode::Halfedge_handle> combining_edges;
+        for(auto facet = unode.facets_begin(); facet != unode.facets_end(); ++facet)
+            for(auto const& h : unode.combinable(*facet))
+                if(
+                    std::none_of(
+                        std::begin(combining_edges),
+                        std::end(combining_edges),
+                        [&h](city::scene::UNode::Halfedge_handle const& present)
+                        {
+                            return  (present->vertex()->point() == h->vertex()->point() && present->opposite()->vertex()->point() == h->opposite()->vertex()->point())
+                                    ||
+                                    (present->opposite()->vertex()->point() == h->vertex()->point() && present->vertex()->point() == h->opposite()->vertex()->point());
+                        }
+                    )
+                )
+                    combining_edges.push_back(h);
+        return combining_edges;
+    }
+
+    /* Reference adjacency: looks every neighbour up in the facet handles */
+    std::vector<bool> adjacency_matrix_from_scratch(city::scene::UNode const& unode)
+    {
+        std::size_t const n = unode.facets_size();
+        std::vector<bool> matrix(n * n, false);
+        auto facets = unode.facet_handles();
+        for(std::size_t line(0); line != n; ++line)
+        {
+            matrix[line * n + line] = true;
+            for(auto adjacent : unode.facet_adjacents(*facets[line]))
+                matrix[line * n + static_cast<std::size_t>(std::distance(std::begin(facets), std::find(std::begin(facets), std::end(facets), adjacent)))] = true;
+        }
+        return matrix;
+    }
+}
+
 SCENARIO("Urban Node manipulation:")
 {
     GIVEN("A 3ds file")
@@ -45,5 +99,155 @@ SCENARIO("Urban Node manipulation:")
                 REQUIRE( auxilary.str() == tmp_str );
             }
         }
+        WHEN("the \"buildings\" are converted into a scene by several workers")
+        {
+            std::vector<city::shadow::Mesh> building_meshes{
+                city::shadow::Mesh(staff_mesh).set_name("first"),
+                city::shadow::Mesh(staff_mesh).set_name("second"),
+                city::shadow::Mesh(staff_mesh).set_name("third")
+            };
+            city::scene::Scene serial(building_meshes, staff_mesh, city::shadow::Point(), 0);
+            city::scene::Scene parallel(std::move(building_meshes), city::shadow::Mesh(staff_mesh), city::shadow::Point(), 0, 3);
+
+            THEN("the nodes are the same and in the same order")
+            {
+                REQUIRE( parallel.identifiers() == serial.identifiers() );
+                for(std::size_t index(0); index != serial.size(); ++index)
+                {
+                    std::ostringstream serial_node, parallel_node;
+                    serial_node << *std::next(serial.cbegin(), static_cast<long>(index));
+                    parallel_node << *std::next(parallel.cbegin(), static_cast<long>(index));
+                    REQUIRE( parallel_node.str() == serial_node.str() );
+                }
+                std::ostringstream serial_terrain, parallel_terrain;
+                serial_terrain << serial.get_terrain();
+                parallel_terrain << parallel.get_terrain();
+                REQUIRE( parallel_terrain.str() == serial_terrain.str() );
+            }
+        }
+        WHEN("a scene is pruned by several workers")
+        {
+            std::vector<city::shadow::Mesh> building_meshes{staff_mesh, staff_mesh};
+            city::scene::Scene parallel(building_meshes, staff_mesh, city::shadow::Point(), 0);
+            parallel.prune(true, 3);
+
+            city::scene::UNode serial(staff_mesh, city::shadow::Point(), 0);
+            city::prune(serial);
+
+            THEN("every node is pruned as it would be alone")
+            {
+                std::ostringstream serial_node;
+                serial_node << serial;
+                for(auto const& building : parallel)
+                {
+                    std::ostringstream parallel_node;
+                    parallel_node << building;
+                    REQUIRE( parallel_node.str() == serial_node.str() );
+                }
+                std::ostringstream parallel_terrain;
+                parallel_terrain << parallel.get_terrain();
+                REQUIRE( parallel_terrain.str() == serial_node.str() );
+            }
+        }
+    }
+    GIVEN("The staff and hammerhead surfaces")
+    {
+        std::vector<city::shadow::Mesh> meshes{
+            city::io::T3DSHandler(
+                boost::filesystem::path("../../ressources/3dModels/3DS/Toy/Toy Santa Claus N180816.3DS"),
+                std::map<std::string,bool>{{"read", true}}
+            ).mesh("Staff", std::set<char>{'S'}),
+            city::io::OFFHandler(
+                boost::filesystem::path("../../ressources/3dModels/OFF/hammerhead.off"),
+                std::map<std::string,bool>{{"read", true}}
+            ).read()
+        };
+
+        WHEN("they are built from flat meshes")
+        {
+            THEN("the surfaces are the same as when built from the meshes")
+            {
+                for(auto const& mesh : meshes)
+                {
+                    city::scene::UNode reference(mesh, city::shadow::Point(), 0), flat(city::shadow::FlatMesh(mesh), city::shadow::Point(), 0);
+
+                    REQUIRE( flat.get_name() == reference.get_name() );
+                    REQUIRE( flat.vertices_size() == reference.vertices_size() );
+                    REQUIRE( flat.facets_size() == reference.facets_size() );
+                    REQUIRE( city::shadow::Mesh(flat) == city::shadow::Mesh(reference) );
+                }
+            }
+            THEN("inconsistently oriented facets are reoriented as in meshes")
+            {
+                city::shadow::FlatMesh tetrahedron("tetrahedron");
+                tetrahedron.add_point(0, 0, 0);
+                tetrahedron.add_point(1, 0, 0);
+                tetrahedron.add_point(0, 1, 0);
+                tetrahedron.add_point(0, 0, 1);
+                for(auto const& face : std::vector< std::vector<std::size_t> >{{0, 1, 2}, {0, 1, 3}, {1, 2, 3}, {0, 3, 2}})
+                    tetrahedron.add_face(std::begin(face), std::end(face));
+
+                city::scene::UNode reference(tetrahedron.to_mesh(), city::shadow::Point(), 0), flat(tetrahedron, city::shadow::Point(), 0);
+                REQUIRE( flat.facets_size() == 4 );
+                REQUIRE( city::shadow::Mesh(flat) == city::shadow::Mesh(reference) );
+            }
+        }
+        WHEN("they are pruned with the facet merging worklist")
+        {
+            THEN("the topology is the same as when restarting from the first halfedge after each join")
+            {
+                for(auto const& mesh : meshes)
+                {
+                    city::scene::UNode reference(mesh, city::shadow::Point(), 0), pruned(mesh, city::shadow::Point(), 0);
+
+                    std::ostringstream expected, output;
+                    expected << prune_from_scratch(reference);
+                    output << city::prune(pruned);
+                    REQUIRE( output.str() == expected.str() );
+                }
+            }
+        }
+        WHEN("their pruning halfedges are collected")
+        {
+            THEN("the hashed deduplication keeps the same halfedges")
+            {
+                for(auto const& mesh : meshes)
+                {
+                    city::scene::UNode unode(mesh, city::shadow::Point(), 0);
+                    REQUIRE( unode.pruning_halfedges() == pruning_halfedges_from_scratch(unode) );
+                }
+            }
+        }
+        WHEN("their facet dual graphs are built")
+        {
+            THEN("the sparse graph expands to the dense adjacency matrix")
+            {
+                for(auto const& mesh : meshes)
+                {
+                    city::scene::UNode unode(mesh, city::shadow::Point(), 0);
+                    auto graph = unode.facet_adjacency();
+                    REQUIRE( graph.size() == unode.facets_size() );
+                    REQUIRE( graph.dense() == adjacency_matrix_from_scratch(unode) );
+                }
+            }
+            THEN("the sparse output lists every edge once")
+            {
+                city::scene::UNode unode(meshes.front(), city::shadow::Point(), 0);
+                auto graph = unode.facet_adjacency();
+
+                std::stringstream output;
+                city::io::Adjacency_stream as(output);
+                as << graph;
+
+                std::size_t row(0), column(0), edges(0);
+                while(output >> row >> column)
+                {
+                    REQUIRE( row < column );
+                    REQUIRE( std::binary_search(graph.neighbours_cbegin(row), graph.neighbours_cend(row), column) );
+                    ++edges;
+                }
+                REQUIRE( edges == graph.edges_size() );
+            }
+        }
     }
 }